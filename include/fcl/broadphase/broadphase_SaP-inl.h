@@ -35,11 +35,15 @@
 
 /** @author Jia Pan */
 
+
 #ifndef FCL_BROAD_PHASE_SAP_INL_H
 #define FCL_BROAD_PHASE_SAP_INL_H
 
 #include "fcl/broadphase/broadphase_SaP.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace fcl
 {
 
@@ -51,57 +55,36 @@ class FCL_EXPORT SaPCollisionManager<double>;
 template <typename S>
 void SaPCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
 {
-  auto it = AABB_arr.begin();
-  for(auto end = AABB_arr.end(); it != end; ++it)
-  {
-    if((*it)->obj == obj)
-      break;
-  }
-
-  AABB_arr.erase(it);
-  obj_aabb_map.erase(obj);
-
-  if(it == AABB_arr.end())
+  auto it = obj_handle_map.find(obj);
+  if(it == obj_handle_map.end())
     return;
 
-  SaPAABB* curr = *it;
-  *it = nullptr;
+  const uint32 handle = it->second;
+  obj_handle_map.erase(it);
 
-  for(int coord = 0; coord < 3; ++coord)
+  for(size_t coord = 0; coord < 3; ++coord)
   {
-    //first delete the lo endpoint of the interval.
-    if(curr->lo->prev[coord] == nullptr)
-      elist[coord] = curr->lo->next[coord];
-    else
-      curr->lo->prev[coord]->next[coord] = curr->lo->next[coord];
+    std::vector<EndPoint>& list = endpoints[coord];
+    const size_t lo = positions[coord][2 * handle];
+    const size_t hi = positions[coord][2 * handle + 1];
 
-    curr->lo->next[coord]->prev[coord] = curr->lo->prev[coord];
+    list.erase(list.begin() + hi);
+    list.erase(list.begin() + lo);
 
-    //then, delete the "hi" endpoint.
-    if(curr->hi->prev[coord] == nullptr)
-      elist[coord] = curr->hi->next[coord];
-    else
-      curr->hi->prev[coord]->next[coord] = curr->hi->next[coord];
-
-    if(curr->hi->next[coord] != nullptr)
-      curr->hi->next[coord]->prev[coord] = curr->hi->prev[coord];
+    for(size_t pos = lo; pos < list.size(); ++pos)
+      setEndPointPos(coord, pos);
   }
 
-  delete curr->lo;
-  delete curr->hi;
-  delete curr;
+  aabbs[handle].obj = nullptr;
+  free_handles.push_back(handle);
 
-  overlap_pairs.remove_if(isUnregistered(obj));
+  overlap_pairs.eraseAll(handle);
 }
-\
+
 //==============================================================================
 template <typename S>
 SaPCollisionManager<S>::SaPCollisionManager()
 {
-  elist[0] = nullptr;
-  elist[1] = nullptr;
-  elist[2] = nullptr;
-
   optimal_axis = 0;
 }
 
@@ -119,186 +102,143 @@ void SaPCollisionManager<S>::registerObjects(const std::vector<CollisionObject<S
   if(other_objs.empty()) return;
 
   if(size() > 0)
-    BroadPhaseCollisionManager<S>::registerObjects(other_objs);
-  else
   {
-    std::vector<EndPoint*> endpoints(2 * other_objs.size());
+    BroadPhaseCollisionManager<S>::registerObjects(other_objs);
+    return;
+  }
 
-    for(size_t i = 0; i < other_objs.size(); ++i)
-    {
-      SaPAABB* sapaabb = new SaPAABB();
-      sapaabb->obj = other_objs[i];
-      sapaabb->lo = new EndPoint();
-      sapaabb->hi = new EndPoint();
-      sapaabb->cached = other_objs[i]->getAABB();
-      endpoints[2 * i] = sapaabb->lo;
-      endpoints[2 * i + 1] = sapaabb->hi;
-      sapaabb->lo->minmax = 0;
-      sapaabb->hi->minmax = 1;
-      sapaabb->lo->aabb = sapaabb;
-      sapaabb->hi->aabb = sapaabb;
-      AABB_arr.push_back(sapaabb);
-      obj_aabb_map[other_objs[i]] = sapaabb;
-    }
+  clear();
 
+  aabbs.resize(other_objs.size());
+  obj_handle_map.reserve(other_objs.size());
+  for(size_t coord = 0; coord < 3; ++coord)
+  {
+    endpoints[coord].resize(2 * other_objs.size());
+    positions[coord].resize(2 * other_objs.size());
+  }
+
+  for(size_t i = 0; i < other_objs.size(); ++i)
+  {
+    SaPAABB& curr = aabbs[i];
+    curr.obj = other_objs[i];
+    curr.cached = other_objs[i]->getAABB();
+    obj_handle_map[other_objs[i]] = static_cast<uint32>(i);
 
-    S scale[3];
     for(size_t coord = 0; coord < 3; ++coord)
     {
-      std::sort(endpoints.begin(), endpoints.end(),
-                std::bind(std::less<S>(),
-                            std::bind(static_cast<S (EndPoint::*)(size_t) const >(&EndPoint::getVal), std::placeholders::_1, coord),
-                            std::bind(static_cast<S (EndPoint::*)(size_t) const >(&EndPoint::getVal), std::placeholders::_2, coord)));
-
-      endpoints[0]->prev[coord] = nullptr;
-      endpoints[0]->next[coord] = endpoints[1];
-      for(size_t i = 1; i < endpoints.size() - 1; ++i)
-      {
-        endpoints[i]->prev[coord] = endpoints[i-1];
-        endpoints[i]->next[coord] = endpoints[i+1];
-      }
-      endpoints[endpoints.size() - 1]->prev[coord] = endpoints[endpoints.size() - 2];
-      endpoints[endpoints.size() - 1]->next[coord] = nullptr;
-
-      elist[coord] = endpoints[0];
-
-      scale[coord] = endpoints.back()->aabb->cached.max_[coord] - endpoints[0]->aabb->cached.min_[coord];
+      EndPoint& lo = endpoints[coord][2 * i];
+      lo.value = curr.cached.min_[coord];
+      lo.aabb = static_cast<uint32>(i);
+      lo.minmax = 0;
+
+      EndPoint& hi = endpoints[coord][2 * i + 1];
+      hi.value = curr.cached.max_[coord];
+      hi.aabb = static_cast<uint32>(i);
+      hi.minmax = 1;
     }
+  }
 
-    int axis = 0;
-    if(scale[axis] < scale[1]) axis = 1;
-    if(scale[axis] < scale[2]) axis = 2;
+  S scale[3];
+  for(size_t coord = 0; coord < 3; ++coord)
+  {
+    std::vector<EndPoint>& list = endpoints[coord];
+    std::sort(list.begin(), list.end(), isLess);
 
-    EndPoint* pos = elist[axis];
+    for(size_t pos = 0; pos < list.size(); ++pos)
+      setEndPointPos(coord, pos);
+    scale[coord] = list.back().value - list.front().value;
+  }
 
-    while(pos != nullptr)
-    {
-      EndPoint* pos_next = nullptr;
-      SaPAABB* aabb = pos->aabb;
-      EndPoint* pos_it = pos->next[axis];
+  size_t axis = 0;
+  if(scale[axis] < scale[1]) axis = 1;
+  if(scale[axis] < scale[2]) axis = 2;
 
-      while(pos_it != nullptr)
+  // sweep along the widest axis, keeping the intervals that contain the
+  // current end point
+  std::vector<uint32> active;
+  std::vector<size_t> active_pos(aabbs.size());
+  for(const EndPoint& e : endpoints[axis])
+  {
+    if(e.minmax == 0)
+    {
+      const AABB<S>& aabb = aabbs[e.aabb].cached;
+      for(uint32 other : active)
       {
-        if(pos_it->aabb == aabb)
-        {
-          if(pos_next == nullptr) pos_next = pos_it;
-          break;
-        }
-
-        if(pos_it->minmax == 0)
-        {
-          if(pos_next == nullptr) pos_next = pos_it;
-          if(pos_it->aabb->cached.overlap(aabb->cached))
-            overlap_pairs.emplace_back(pos_it->aabb->obj, aabb->obj);
-        }
-        pos_it = pos_it->next[axis];
+        if(aabbs[other].cached.overlap(aabb))
+          overlap_pairs.insert(other, e.aabb);
       }
 
-      pos = pos_next;
+      active_pos[e.aabb] = active.size();
+      active.push_back(e.aabb);
+    }
+    else
+    {
+      const size_t pos = active_pos[e.aabb];
+      active[pos] = active.back();
+      active_pos[active[pos]] = pos;
+      active.pop_back();
     }
   }
 
-  updateVelist();
+  optimal_axis = axis;
 }
 
 //==============================================================================
 template <typename S>
 void SaPCollisionManager<S>::registerObject(CollisionObject<S>* obj)
 {
-  SaPAABB* curr = new SaPAABB;
-  curr->cached = obj->getAABB();
-  curr->obj = obj;
-  curr->lo = new EndPoint;
-  curr->lo->minmax = 0;
-  curr->lo->aabb = curr;
-
-  curr->hi = new EndPoint;
-  curr->hi->minmax = 1;
-  curr->hi->aabb = curr;
-
-  for(int coord = 0; coord < 3; ++coord)
+  uint32 handle;
+  if(free_handles.empty())
   {
-    EndPoint* current = elist[coord];
+    handle = static_cast<uint32>(aabbs.size());
+    aabbs.emplace_back();
+    for(size_t coord = 0; coord < 3; ++coord)
+      positions[coord].resize(2 * aabbs.size());
+  }
+  else
+  {
+    handle = free_handles.back();
+    free_handles.pop_back();
+  }
 
-    // first insert the lo end point
-    if(current == nullptr) // empty list
-    {
-      elist[coord] = curr->lo;
-      curr->lo->prev[coord] = curr->lo->next[coord] = nullptr;
-    }
-    else // otherwise, find the correct location in the list and insert
-    {
-      EndPoint* curr_lo = curr->lo;
-      S curr_lo_val = curr_lo->getVal()[coord];
-      while((current->getVal()[coord] < curr_lo_val) && (current->next[coord] != nullptr))
-        current = current->next[coord];
+  SaPAABB& curr = aabbs[handle];
+  curr.obj = obj;
+  curr.cached = obj->getAABB();
+  obj_handle_map[obj] = handle;
 
-      if(current->getVal()[coord] >= curr_lo_val)
-      {
-        curr_lo->prev[coord] = current->prev[coord];
-        curr_lo->next[coord] = current;
-        if(current->prev[coord] == nullptr)
-          elist[coord] = curr_lo;
-        else
-          current->prev[coord]->next[coord] = curr_lo;
+  for(size_t coord = 0; coord < 3; ++coord)
+  {
+    std::vector<EndPoint>& list = endpoints[coord];
 
-        current->prev[coord] = curr_lo;
-      }
-      else
-      {
-        curr_lo->prev[coord] = current;
-        curr_lo->next[coord] = nullptr;
-        current->next[coord] = curr_lo;
-      }
-    }
+    EndPoint lo;
+    lo.value = curr.cached.min_[coord];
+    lo.aabb = handle;
+    lo.minmax = 0;
 
-    // now insert hi end point
-    current = curr->lo;
+    EndPoint hi;
+    hi.value = curr.cached.max_[coord];
+    hi.aabb = handle;
+    hi.minmax = 1;
 
-    EndPoint* curr_hi = curr->hi;
-    S curr_hi_val = curr_hi->getVal()[coord];
+    const auto lo_it = list.insert(
+          std::upper_bound(list.begin(), list.end(), lo, isLess), lo);
+    const auto hi_it = list.insert(
+          std::upper_bound(lo_it + 1, list.end(), hi, isLess), hi);
 
+    for(size_t pos = lo_it - list.begin(); pos < list.size(); ++pos)
+      setEndPointPos(coord, pos);
+
+    // all the intervals overlapping the new one start before its end
     if(coord == 0)
     {
-      while((current->getVal()[coord] < curr_hi_val) && (current->next[coord] != nullptr))
+      for(auto it = list.begin(); it != hi_it; ++it)
       {
-        if(current != curr->lo)
-          if(current->aabb->cached.overlap(curr->cached))
-            overlap_pairs.emplace_back(current->aabb->obj, obj);
-
-        current = current->next[coord];
+        if(it->minmax == 0 && it->aabb != handle
+           && aabbs[it->aabb].cached.overlap(curr.cached))
+          overlap_pairs.insert(it->aabb, handle);
       }
     }
-    else
-    {
-      while((current->getVal()[coord] < curr_hi_val) && (current->next[coord] != nullptr))
-        current = current->next[coord];
-    }
-
-    if(current->getVal()[coord] >= curr_hi_val)
-    {
-      curr_hi->prev[coord] = current->prev[coord];
-      curr_hi->next[coord] = current;
-      if(current->prev[coord] == nullptr)
-        elist[coord] = curr_hi;
-      else
-        current->prev[coord]->next[coord] = curr_hi;
-
-      current->prev[coord] = curr_hi;
-    }
-    else
-    {
-      curr_hi->prev[coord] = current;
-      curr_hi->next[coord] = nullptr;
-      current->next[coord] = curr_hi;
-    }
   }
-
-  AABB_arr.push_back(curr);
-
-  obj_aabb_map[obj] = curr;
-
-  updateVelist();
 }
 
 //==============================================================================
@@ -308,9 +248,9 @@ void SaPCollisionManager<S>::setup()
   if(size() == 0) return;
 
   S scale[3];
-  scale[0] = (velist[0].back())->getVal(0) - velist[0][0]->getVal(0);
-  scale[1] = (velist[1].back())->getVal(1) - velist[1][0]->getVal(1);;
-  scale[2] = (velist[2].back())->getVal(2) - velist[2][0]->getVal(2);
+  for(size_t coord = 0; coord < 3; ++coord)
+    scale[coord] = endpoints[coord].back().value - endpoints[coord].front().value;
+
   size_t axis = 0;
   if(scale[axis] < scale[1]) axis = 1;
   if(scale[axis] < scale[2]) axis = 2;
@@ -319,173 +259,205 @@ void SaPCollisionManager<S>::setup()
 
 //==============================================================================
 template <typename S>
-void SaPCollisionManager<S>::update_(SaPAABB* updated_aabb)
+void SaPCollisionManager<S>::update_(const std::vector<uint32>& handles)
 {
-  if(updated_aabb->cached.equal(updated_aabb->obj->getAABB()))
+  // Moving the end points one interval at a time writes back the position of
+  // every end point it passes. Once most of the intervals move, it is cheaper
+  // to sort all the end points together and to record their positions after.
+  if(4 * handles.size() < size())
+  {
+    for(uint32 handle : handles)
+      moveInterval(handle);
     return;
+  }
 
-  SaPAABB* current = updated_aabb;
+  for(uint32 handle : handles)
+    aabbs[handle].cached = aabbs[handle].obj->getAABB();
 
-  Vector3<S> new_min = current->obj->getAABB().min_;
-  Vector3<S> new_max = current->obj->getAABB().max_;
+  sortEndPoints();
 
-  SaPAABB dummy;
-  dummy.cached = current->obj->getAABB();
+  for(size_t coord = 0; coord < 3; ++coord)
+  {
+    for(size_t pos = 0; pos < endpoints[coord].size(); ++pos)
+      setEndPointPos(coord, pos);
+  }
+}
 
-  for(int coord = 0; coord < 3; ++coord)
+//==============================================================================
+template <typename S>
+void SaPCollisionManager<S>::moveInterval(uint32 handle)
+{
+  SaPAABB& curr = aabbs[handle];
+  const AABB<S>& new_aabb = curr.obj->getAABB();
+
+  // the pair tests done while moving the end points use the new AABB, and
+  // the old one to skip the removal of pairs that were not overlapping
+  const AABB<S> old_aabb = curr.cached;
+  curr.cached = new_aabb;
+
+  for(size_t coord = 0; coord < 3; ++coord)
   {
-    int direction; // -1 reverse, 0 nochange, 1 forward
-    EndPoint* temp;
+    std::vector<EndPoint>& list = endpoints[coord];
+    const size_t lo = positions[coord][2 * handle];
+    const size_t hi = positions[coord][2 * handle + 1];
+    list[lo].value = new_aabb.min_[coord];
+    list[hi].value = new_aabb.max_[coord];
+
+    // move first the end point that cannot pass the other one, and then the
+    // other one, whose position is not changed by the first move
+    if(new_aabb.min_[coord] < old_aabb.min_[coord])
+    {
+      moveEndPoint(coord, lo, old_aabb);
+      moveEndPoint(coord, hi, old_aabb);
+    }
+    else
+    {
+      moveEndPoint(coord, hi, old_aabb);
+      moveEndPoint(coord, lo, old_aabb);
+    }
+  }
+}
 
-    if(current->lo->getVal(coord) > new_min[coord])
-      direction = -1;
-    else if(current->lo->getVal(coord) < new_min[coord])
-      direction = 1;
-    else direction = 0;
+//==============================================================================
+template <typename S>
+void SaPCollisionManager<S>::moveEndPoint(
+    size_t coord, size_t pos, const AABB<S>& old_aabb)
+{
+  std::vector<EndPoint>& list = endpoints[coord];
+  const EndPoint e = list[pos];
+  const AABB<S>& aabb = aabbs[e.aabb].cached;
 
-    if(direction == -1)
+  size_t i = pos;
+  while(i > 0 && isLess(e, list[i - 1]))
+  {
+    const EndPoint& other = list[i - 1];
+    if(e.minmax == 0 && other.minmax == 1)
     {
-      //first update the "lo" endpoint of the interval
-      if(current->lo->prev[coord] != nullptr)
-      {
-        temp = current->lo;
-        while((temp != nullptr) && (temp->getVal(coord) > new_min[coord]))
-        {
-          if(temp->minmax == 1)
-            if(temp->aabb->cached.overlap(dummy.cached))
-              addToOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-          temp = temp->prev[coord];
-        }
+      // now starts before the end of other
+      if(aabbs[other.aabb].cached.overlap(aabb))
+        overlap_pairs.insert(other.aabb, e.aabb);
+    }
+    else if(e.minmax == 1 && other.minmax == 0)
+    {
+      // now ends before the start of other
+      if(aabbs[other.aabb].cached.overlap(old_aabb))
+        overlap_pairs.erase(other.aabb, e.aabb);
+    }
 
-        if(temp == nullptr)
-        {
-          current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-          current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-          current->lo->prev[coord] = nullptr;
-          current->lo->next[coord] = elist[coord];
-          elist[coord]->prev[coord] = current->lo;
-          elist[coord] = current->lo;
-        }
-        else
-        {
-          current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-          current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-          current->lo->prev[coord] = temp;
-          current->lo->next[coord] = temp->next[coord];
-          temp->next[coord]->prev[coord] = current->lo;
-          temp->next[coord] = current->lo;
-        }
-      }
+    list[i] = other;
+    setEndPointPos(coord, i);
+    --i;
+  }
 
-      current->lo->getVal(coord) = new_min[coord];
+  while(i + 1 < list.size() && isLess(list[i + 1], e))
+  {
+    const EndPoint& other = list[i + 1];
+    if(e.minmax == 1 && other.minmax == 0)
+    {
+      // now ends after the start of other
+      if(aabbs[other.aabb].cached.overlap(aabb))
+        overlap_pairs.insert(other.aabb, e.aabb);
+    }
+    else if(e.minmax == 0 && other.minmax == 1)
+    {
+      // now starts after the end of other
+      if(aabbs[other.aabb].cached.overlap(old_aabb))
+        overlap_pairs.erase(other.aabb, e.aabb);
+    }
 
-      // update hi end point
-      temp = current->hi;
-      while(temp->getVal(coord) > new_max[coord])
-      {
-        if((temp->minmax == 0) && (temp->aabb->cached.overlap(current->cached)))
-          removeFromOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-        temp = temp->prev[coord];
-      }
+    list[i] = other;
+    setEndPointPos(coord, i);
+    ++i;
+  }
 
-      current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-      if(current->hi->next[coord] != nullptr)
-        current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-      current->hi->prev[coord] = temp;
-      current->hi->next[coord] = temp->next[coord];
-      if(temp->next[coord] != nullptr)
-        temp->next[coord]->prev[coord] = current->hi;
-      temp->next[coord] = current->hi;
+  list[i] = e;
+  setEndPointPos(coord, i);
+}
 
-      current->hi->getVal(coord) = new_max[coord];
+//==============================================================================
+template <typename S>
+void SaPCollisionManager<S>::sortEndPoints()
+{
+  for(size_t coord = 0; coord < 3; ++coord)
+  {
+    std::vector<EndPoint>& list = endpoints[coord];
+    for(EndPoint& e : list)
+    {
+      const AABB<S>& aabb = aabbs[e.aabb].cached;
+      e.value = e.minmax ? aabb.max_[coord] : aabb.min_[coord];
     }
-    else if(direction == 1)
+
+    // Insertion sort swaps each pair of end points whose order changed once,
+    // so the intervals of the pair that become overlapping along coord are
+    // tested with the new AABBs, and the ones that stop overlapping are
+    // removed.
+    for(size_t i = 1; i < list.size(); ++i)
     {
-      //here, we first update the "hi" endpoint.
-      if(current->hi->next[coord] != nullptr)
-      {
-        temp = current->hi;
-        while((temp->next[coord] != nullptr) && (temp->getVal(coord) < new_max[coord]))
-        {
-          if(temp->minmax == 0)
-            if(temp->aabb->cached.overlap(dummy.cached))
-              addToOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-          temp = temp->next[coord];
-        }
+      if(!isLess(list[i], list[i - 1]))
+        continue;
 
-        if(temp->getVal(coord) < new_max[coord])
+      const EndPoint e = list[i];
+      size_t j = i;
+      do
+      {
+        const EndPoint& other = list[j - 1];
+        if(e.minmax == 0 && other.minmax == 1)
         {
-          current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-          current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-          current->hi->prev[coord] = temp;
-          current->hi->next[coord] = nullptr;
-          temp->next[coord] = current->hi;
+          // now starts before the end of other
+          if(aabbs[other.aabb].cached.overlap(aabbs[e.aabb].cached))
+            overlap_pairs.insert(other.aabb, e.aabb);
         }
-        else
+        else if(e.minmax == 1 && other.minmax == 0)
         {
-          current->hi->prev[coord]->next[coord] = current->hi->next[coord];
-          current->hi->next[coord]->prev[coord] = current->hi->prev[coord];
-          current->hi->prev[coord] = temp->prev[coord];
-          current->hi->next[coord] = temp;
-          temp->prev[coord]->next[coord] = current->hi;
-          temp->prev[coord] = current->hi;
+          // now ends before the start of other
+          overlap_pairs.erase(other.aabb, e.aabb);
         }
-      }
-
-      current->hi->getVal(coord) = new_max[coord];
-
-      //then, update the "lo" endpoint of the interval.
-      temp = current->lo;
 
-      while(temp->getVal(coord) < new_min[coord])
-      {
-        if((temp->minmax == 1) && (temp->aabb->cached.overlap(current->cached)))
-          removeFromOverlapPairs(SaPPair(temp->aabb->obj, current->obj));
-        temp = temp->next[coord];
-      }
+        list[j] = other;
+        --j;
+      } while(j > 0 && isLess(e, list[j - 1]));
 
-      if(current->lo->prev[coord] != nullptr)
-        current->lo->prev[coord]->next[coord] = current->lo->next[coord];
-      else
-        elist[coord] = current->lo->next[coord];
-      current->lo->next[coord]->prev[coord] = current->lo->prev[coord];
-      current->lo->prev[coord] = temp->prev[coord];
-      current->lo->next[coord] = temp;
-      if(temp->prev[coord] != nullptr)
-        temp->prev[coord]->next[coord] = current->lo;
-      else
-        elist[coord] = current->lo;
-      temp->prev[coord] = current->lo;
-      current->lo->getVal(coord) = new_min[coord];
+      list[j] = e;
     }
   }
 }
 
 //==============================================================================
 template <typename S>
-void SaPCollisionManager<S>::updateVelist()
+void SaPCollisionManager<S>::setEndPointPos(size_t coord, size_t pos)
 {
-  for(int coord = 0; coord < 3; ++coord)
-  {
-    velist[coord].resize(size() * 2);
-    EndPoint* current = elist[coord];
-    size_t id = 0;
-    while(current)
-    {
-      velist[coord][id] = current;
-      current = current->next[coord];
-      id++;
-    }
-  }
+  const EndPoint& e = endpoints[coord][pos];
+  positions[coord][2 * e.aabb + e.minmax] = static_cast<uint32>(pos);
+}
+
+//==============================================================================
+template <typename S>
+bool SaPCollisionManager<S>::isLess(const EndPoint& a, const EndPoint& b)
+{
+  return (a.value < b.value) || ((a.value == b.value) && (a.minmax < b.minmax));
+}
+
+//==============================================================================
+template <typename S>
+size_t SaPCollisionManager<S>::upperBound(size_t axis, S val) const
+{
+  const std::vector<EndPoint>& list = endpoints[axis];
+  const auto it = std::upper_bound(
+        list.begin(), list.end(), val,
+        [](S v, const EndPoint& e) { return v < e.value; });
+  return it - list.begin();
 }
 
 //==============================================================================
 template <typename S>
 void SaPCollisionManager<S>::update(CollisionObject<S>* updated_obj)
 {
-  update_(obj_aabb_map[updated_obj]);
+  const auto it = obj_handle_map.find(updated_obj);
+  if(it == obj_handle_map.end())
+    return;
 
-  updateVelist();
+  if(!aabbs[it->second].cached.equal(updated_obj->getAABB()))
+    moveInterval(it->second);
 
   setup();
 }
@@ -494,10 +466,16 @@ void SaPCollisionManager<S>::update(CollisionObject<S>* updated_obj)
 template <typename S>
 void SaPCollisionManager<S>::update(const std::vector<CollisionObject<S>*>& updated_objs)
 {
+  updated_handles.clear();
   for(size_t i = 0; i < updated_objs.size(); ++i)
-    update_(obj_aabb_map[updated_objs[i]]);
+  {
+    const auto it = obj_handle_map.find(updated_objs[i]);
+    if(it != obj_handle_map.end()
+       && !aabbs[it->second].cached.equal(updated_objs[i]->getAABB()))
+      updated_handles.push_back(it->second);
+  }
 
-  updateVelist();
+  update_(updated_handles);
 
   setup();
 }
@@ -506,12 +484,15 @@ void SaPCollisionManager<S>::update(const std::vector<CollisionObject<S>*>& upda
 template <typename S>
 void SaPCollisionManager<S>::update()
 {
-  for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
+  updated_handles.clear();
+  for(size_t i = 0; i < aabbs.size(); ++i)
   {
-    update_(*it);
+    const SaPAABB& aabb = aabbs[i];
+    if(aabb.obj && !aabb.cached.equal(aabb.obj->getAABB()))
+      updated_handles.push_back(static_cast<uint32>(i));
   }
 
-  updateVelist();
+  update_(updated_handles);
 
   setup();
 }
@@ -520,37 +501,30 @@ void SaPCollisionManager<S>::update()
 template <typename S>
 void SaPCollisionManager<S>::clear()
 {
-  for(auto it = AABB_arr.begin(), end = AABB_arr.end(); it != end; ++it)
+  aabbs.clear();
+  free_handles.clear();
+
+  for(size_t coord = 0; coord < 3; ++coord)
   {
-    delete (*it)->hi;
-    delete (*it)->lo;
-    delete *it;
-    *it = nullptr;
+    endpoints[coord].clear();
+    positions[coord].clear();
   }
 
-  AABB_arr.clear();
   overlap_pairs.clear();
 
-  elist[0] = nullptr;
-  elist[1] = nullptr;
-  elist[2] = nullptr;
-
-  velist[0].clear();
-  velist[1].clear();
-  velist[2].clear();
-
-  obj_aabb_map.clear();
+  obj_handle_map.clear();
 }
 
 //==============================================================================
 template <typename S>
 void SaPCollisionManager<S>::getObjects(std::vector<CollisionObject<S>*>& objs) const
 {
-  objs.resize(AABB_arr.size());
-  int i = 0;
-  for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it, ++i)
+  objs.clear();
+  objs.reserve(size());
+  for(const SaPAABB& aabb : aabbs)
   {
-    objs[i] = (*it)->obj;
+    if(aabb.obj)
+      objs.push_back(aabb.obj);
   }
 }
 
@@ -562,79 +536,27 @@ bool SaPCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cdata, Coll
   const AABB<S>& obj_aabb = obj->getAABB();
 
   S min_val = obj_aabb.min_[axis];
-  //  S max_val = obj_aabb.max_[axis];
-
-  EndPoint dummy;
-  SaPAABB dummy_aabb;
-  dummy_aabb.cached = obj_aabb;
-  dummy.minmax = 1;
-  dummy.aabb = &dummy_aabb;
 
   // compute stop_pos by binary search, this is cheaper than check it in while iteration linearly
-  const auto res_it = std::upper_bound(velist[axis].begin(), velist[axis].end(), &dummy,
-                                                                   std::bind(std::less<S>(),
-                                                                               std::bind(static_cast<S (EndPoint::*)(size_t) const>(&EndPoint::getVal), std::placeholders::_1, axis),
-                                                                               std::bind(static_cast<S (EndPoint::*)(size_t) const>(&EndPoint::getVal), std::placeholders::_2, axis)));
-
-  EndPoint* end_pos = nullptr;
-  if(res_it != velist[axis].end())
-    end_pos = *res_it;
+  const std::vector<EndPoint>& list = endpoints[axis];
+  const size_t end_pos = upperBound(axis, obj_aabb.max_[axis]);
 
-  EndPoint* pos = elist[axis];
-
-  while(pos != end_pos)
+  for(size_t pos = 0; pos < end_pos; ++pos)
   {
-    if(pos->aabb->obj != obj)
-    {
-      if((pos->minmax == 0) && (pos->aabb->hi->getVal(axis) >= min_val))
-      {
-        if(pos->aabb->cached.overlap(obj->getAABB()))
-          if(callback(obj, pos->aabb->obj, cdata))
-            return true;
-      }
-    }
-    pos = pos->next[axis];
-  }
+    const EndPoint& e = list[pos];
+    if(e.minmax != 0)
+      continue;
 
-  return false;
-}
-
-//==============================================================================
-template <typename S>
-void SaPCollisionManager<S>::addToOverlapPairs(
-    const typename SaPCollisionManager<S>::SaPPair& p)
-{
-  bool repeated = false;
-  for(auto it = overlap_pairs.begin(), end = overlap_pairs.end(); it != end; ++it)
-  {
-    if(*it == p)
+    const SaPAABB& aabb = aabbs[e.aabb];
+    if(aabb.obj != obj && aabb.cached.max_[axis] >= min_val)
     {
-      repeated = true;
-      break;
-    }
-  }
-
-  if(!repeated)
-    overlap_pairs.push_back(p);
-}
-
-//==============================================================================
-template <typename S>
-void SaPCollisionManager<S>::removeFromOverlapPairs(
-    const typename SaPCollisionManager<S>::SaPPair& p)
-{
-  for(auto it = overlap_pairs.begin(), end = overlap_pairs.end();
-      it != end;
-      ++it)
-  {
-    if(*it == p)
-    {
-      overlap_pairs.erase(it);
-      break;
+      if(aabb.cached.overlap(obj_aabb))
+        if(callback(obj, aabb.obj, cdata))
+          return true;
     }
   }
 
-  // or overlap_pairs.remove_if(isNotValidPair(p));
+  return false;
 }
 
 //==============================================================================
@@ -660,48 +582,35 @@ bool SaPCollisionManager<S>::distance_(CollisionObject<S>* obj, void* cdata, Dis
   }
 
   size_t axis = optimal_axis;
+  const std::vector<EndPoint>& list = endpoints[axis];
 
   int status = 1;
   S old_min_distance;
 
-  EndPoint* start_pos = elist[axis];
-
   while(1)
   {
     old_min_distance = min_dist;
     S min_val = aabb.min_[axis];
-    //    S max_val = aabb.max_[axis];
-
-    EndPoint dummy;
-    SaPAABB dummy_aabb;
-    dummy_aabb.cached = aabb;
-    dummy.minmax = 1;
-    dummy.aabb = &dummy_aabb;
-
 
-    const auto res_it = std::upper_bound(velist[axis].begin(), velist[axis].end(), &dummy,
-                                                                     std::bind(std::less<S>(),
-                                                                                 std::bind(static_cast<S (EndPoint::*)(size_t) const>(&EndPoint::getVal), std::placeholders::_1, axis),
-                                                                                 std::bind(static_cast<S (EndPoint::*)(size_t) const>(&EndPoint::getVal), std::placeholders::_2, axis)));
+    const size_t end_pos = upperBound(axis, aabb.max_[axis]);
 
-    EndPoint* end_pos = nullptr;
-    if(res_it != velist[axis].end())
-      end_pos = *res_it;
-
-    EndPoint* pos = start_pos;
-
-    while(pos != end_pos)
+    for(size_t pos = 0; pos < end_pos; ++pos)
     {
-      // can change to pos->aabb->hi->getVal(axis) >= min_val - min_dist, and then update start_pos to end_pos.
-      // but this seems slower.
-      if((pos->minmax == 0) && (pos->aabb->hi->getVal(axis) >= min_val))
+      // can change to hi >= min_val - min_dist, and then update the start
+      // position to end_pos, but this seems slower.
+      const EndPoint& e = list[pos];
+      if(e.minmax != 0)
+        continue;
+
+      const SaPAABB& curr = aabbs[e.aabb];
+      if(curr.cached.max_[axis] >= min_val)
       {
-        CollisionObject<S>* curr_obj = pos->aabb->obj;
+        CollisionObject<S>* curr_obj = curr.obj;
         if(curr_obj != obj)
         {
           if(!this->enable_tested_set_)
           {
-            if(pos->aabb->cached.distance(obj->getAABB()) < min_dist)
+            if(curr.cached.distance(obj->getAABB()) < min_dist)
             {
               if(callback(curr_obj, obj, cdata, min_dist))
                 return true;
@@ -711,7 +620,7 @@ bool SaPCollisionManager<S>::distance_(CollisionObject<S>* obj, void* cdata, Dis
           {
             if(!this->inTestedSet(curr_obj, obj))
             {
-              if(pos->aabb->cached.distance(obj->getAABB()) < min_dist)
+              if(curr.cached.distance(obj->getAABB()) < min_dist)
               {
                 if(callback(curr_obj, obj, cdata, min_dist))
                   return true;
@@ -722,8 +631,6 @@ bool SaPCollisionManager<S>::distance_(CollisionObject<S>* obj, void* cdata, Dis
           }
         }
       }
-
-      pos = pos->next[axis];
     }
 
     if(status == 1)
@@ -771,10 +678,10 @@ void SaPCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback)
 {
   if(size() == 0) return;
 
-  for(auto it = overlap_pairs.cbegin(), end = overlap_pairs.cend(); it != end; ++it)
+  for(const detail::PairHashSet::Pair& pair : overlap_pairs.getPairs())
   {
-    CollisionObject<S>* obj1 = it->obj1;
-    CollisionObject<S>* obj2 = it->obj2;
+    CollisionObject<S>* obj1 = aabbs[pair.first].obj;
+    CollisionObject<S>* obj2 = aabbs[pair.second].obj;
 
     if(callback(obj1, obj2, cdata))
       return;
@@ -792,9 +699,9 @@ void SaPCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback)
 
   S min_dist = std::numeric_limits<S>::max();
 
-  for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
+  for(const SaPAABB& aabb : aabbs)
   {
-    if(distance_((*it)->obj, cdata, callback, min_dist))
+    if(aabb.obj && distance_(aabb.obj, cdata, callback, min_dist))
       break;
   }
 
@@ -818,17 +725,17 @@ void SaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manage
 
   if(this->size() < other_manager->size())
   {
-    for(auto it = AABB_arr.cbegin(); it != AABB_arr.cend(); ++it)
+    for(const SaPAABB& aabb : aabbs)
     {
-      if(other_manager->collide_((*it)->obj, cdata, callback))
+      if(aabb.obj && other_manager->collide_(aabb.obj, cdata, callback))
         return;
     }
   }
   else
   {
-    for(auto it = other_manager->AABB_arr.cbegin(), end = other_manager->AABB_arr.cend(); it != end; ++it)
+    for(const SaPAABB& aabb : other_manager->aabbs)
     {
-      if(collide_((*it)->obj, cdata, callback))
+      if(aabb.obj && collide_(aabb.obj, cdata, callback))
         return;
     }
   }
@@ -852,17 +759,17 @@ void SaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manag
 
   if(this->size() < other_manager->size())
   {
-    for(auto it = AABB_arr.cbegin(), end = AABB_arr.cend(); it != end; ++it)
+    for(const SaPAABB& aabb : aabbs)
     {
-      if(other_manager->distance_((*it)->obj, cdata, callback, min_dist))
+      if(aabb.obj && other_manager->distance_(aabb.obj, cdata, callback, min_dist))
         return;
     }
   }
   else
   {
-    for(auto it = other_manager->AABB_arr.cbegin(), end = other_manager->AABB_arr.cend(); it != end; ++it)
+    for(const SaPAABB& aabb : other_manager->aabbs)
     {
-      if(distance_((*it)->obj, cdata, callback, min_dist))
+      if(aabb.obj && distance_(aabb.obj, cdata, callback, min_dist))
         return;
     }
   }
@@ -872,100 +779,14 @@ void SaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manag
 template <typename S>
 bool SaPCollisionManager<S>::empty() const
 {
-  return AABB_arr.size();
+  return obj_handle_map.empty();
 }
 
 //==============================================================================
 template <typename S>
 size_t SaPCollisionManager<S>::size() const
 {
-  return AABB_arr.size();
-}
-
-//==============================================================================
-template <typename S>
-const Vector3<S>&SaPCollisionManager<S>::EndPoint::getVal() const
-{
-  if(minmax) return aabb->cached.max_;
-  else return aabb->cached.min_;
-}
-
-//==============================================================================
-template <typename S>
-Vector3<S>&SaPCollisionManager<S>::EndPoint::getVal()
-{
-  if(minmax) return aabb->cached.max_;
-  else return aabb->cached.min_;
-}
-
-//==============================================================================
-template <typename S>
-S SaPCollisionManager<S>::EndPoint::getVal(size_t i) const
-{
-  if(minmax)
-    return aabb->cached.max_[i];
-  else
-    return aabb->cached.min_[i];
-}
-
-//==============================================================================
-template <typename S>
-S& SaPCollisionManager<S>::EndPoint::getVal(size_t i)
-{
-  if(minmax)
-    return aabb->cached.max_[i];
-  else
-    return aabb->cached.min_[i];
-}
-
-//==============================================================================
-template <typename S>
-SaPCollisionManager<S>::SaPPair::SaPPair(CollisionObject<S>* a, CollisionObject<S>* b)
-{
-  if(a < b)
-  {
-    obj1 = a;
-    obj2 = b;
-  }
-  else
-  {
-    obj1 = b;
-    obj2 = a;
-  }
-}
-
-//==============================================================================
-template <typename S>
-bool SaPCollisionManager<S>::SaPPair::operator ==(const typename SaPCollisionManager<S>::SaPPair& other) const
-{
-  return ((obj1 == other.obj1) && (obj2 == other.obj2));
-}
-
-//==============================================================================
-template <typename S>
-SaPCollisionManager<S>::isUnregistered::isUnregistered(CollisionObject<S>* obj_) : obj(obj_)
-{}
-
-//==============================================================================
-template <typename S>
-bool SaPCollisionManager<S>::isUnregistered::operator()(const SaPPair& pair) const
-{
-  return (pair.obj1 == obj) || (pair.obj2 == obj);
-}
-
-//==============================================================================
-template <typename S>
-SaPCollisionManager<S>::isNotValidPair::isNotValidPair(CollisionObject<S>* obj1_, CollisionObject<S>* obj2_) : obj1(obj1_),
-  obj2(obj2_)
-{
-  // Do nothing
-}
-
-//==============================================================================
-template <typename S>
-bool SaPCollisionManager<S>::isNotValidPair::operator()(const SaPPair& pair)
-{
-  return (pair.obj1 == obj1) && (pair.obj2 == obj2);
+  return obj_handle_map.size();
 }
 
 } // namespace fcl
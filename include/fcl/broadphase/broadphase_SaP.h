@@ -38,10 +38,11 @@
 #ifndef FCL_BROAD_PHASE_SAP_H
 #define FCL_BROAD_PHASE_SAP_H
 
-#include <map>
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/broadphase/detail/pair_hash_set.h"
 
 namespace fcl
 {
@@ -115,42 +116,62 @@ protected:
   /// @brief End point for an interval
   struct EndPoint;
 
-  /// @brief A pair of objects that are not culling away and should further check collision
-  struct SaPPair;
+  /// @brief Update the intervals of the given handles, whose objects have
+  /// new AABBs
+  void update_(const std::vector<uint32>& handles);
 
-  /// @brief Functor to help unregister one object
-  class FCL_EXPORT isUnregistered;
+  /// @brief Move the end points of one interval to the places of its new AABB
+  void moveInterval(uint32 handle);
 
-  /// @brief Functor to help remove collision pairs no longer valid (i.e., should be culled away)
-  class FCL_EXPORT isNotValidPair;
+  /// @brief Move the end point at pos of the sorted list of coord to the place
+  /// of its (already changed) value, updating the overlapping pairs on the way;
+  /// old_aabb is the AABB of the interval before the change
+  void moveEndPoint(size_t coord, size_t pos, const AABB<S>& old_aabb);
 
-  void update_(SaPAABB* updated_aabb);
+  /// @brief Copy the cached AABBs into the end points and restore their order
+  /// by insertion sort, updating the overlapping pairs on each swap
+  void sortEndPoints();
 
-  void updateVelist();
+  /// @brief Record the new position of the end point at pos of coord
+  void setEndPointPos(size_t coord, size_t pos);
 
-  /// @brief End point list for x, y, z coordinates
-  EndPoint* elist[3];
-  
-  /// @brief vector version of elist, for acceleration
-  std::vector<EndPoint*> velist[3];
+  /// @brief Whether the end point a goes before b in a sorted list; with equal
+  /// values the lower bounds go first, so that touching intervals overlap
+  static bool isLess(const EndPoint& a, const EndPoint& b);
+
+  /// @brief The position of the first end point along axis with value larger
+  /// than val
+  size_t upperBound(size_t axis, S val) const;
+
+  /// @brief SAP intervals, indexed by handle; the free ones have a null obj
+  std::vector<SaPAABB> aabbs;
 
-  /// @brief SAP interval list
-  std::list<SaPAABB*> AABB_arr;
+  /// @brief The handles of the free SAP intervals
+  std::vector<uint32> free_handles;
 
-  /// @brief The pair of objects that should further check for collision
-  std::list<SaPPair> overlap_pairs;
+  /// @brief End points sorted along x, y, z coordinates
+  std::vector<EndPoint> endpoints[3];
+
+  /// @brief Positions of the end points in the lists of x, y, z coordinates;
+  /// the lower bound of handle i is at 2 * i and its higher bound at 2 * i + 1.
+  /// They are apart from the intervals so that the writes done while moving
+  /// the end points hit a small array.
+  std::vector<uint32> positions[3];
+
+  /// @brief The pairs of handles of the objects that should further check for
+  /// collision
+  detail::PairHashSet overlap_pairs;
 
   size_t optimal_axis;
 
-  std::map<CollisionObject<S>*, SaPAABB*> obj_aabb_map;
+  std::unordered_map<CollisionObject<S>*, uint32> obj_handle_map;
+
+  /// @brief The handles of the intervals to update, kept to reuse its memory
+  std::vector<uint32> updated_handles;
 
   bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
 
   bool collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
-
-  void addToOverlapPairs(const SaPPair& p);
-
-  void removeFromOverlapPairs(const SaPPair& p);
 };
 
 using SaPCollisionManagerf = SaPCollisionManager<float>;
@@ -163,12 +184,6 @@ struct SaPCollisionManager<S>::SaPAABB
   /// @brief object
   CollisionObject<S>* obj;
 
-  /// @brief lower bound end point of the interval
-  typename SaPCollisionManager<S>::EndPoint* lo;
-
-  /// @brief higher bound end point of the interval
-  typename SaPCollisionManager<S>::EndPoint* hi;
-
   /// @brief cached AABB<S> value
   AABB<S> cached;
 };
@@ -177,65 +192,14 @@ struct SaPCollisionManager<S>::SaPAABB
 template <typename S>
 struct SaPCollisionManager<S>::EndPoint
 {
-  /// @brief tag for whether it is a lower bound or higher bound of an interval, 0 for lo, and 1 for hi
-  char minmax;
-
-  /// @brief back pointer to SAP interval
-  typename SaPCollisionManager<S>::SaPAABB* aabb;
-
-  /// @brief the previous end point in the end point list
-  EndPoint* prev[3];
-
-  /// @brief the next end point in the end point list
-  EndPoint* next[3];
-
-  /// @brief get the value of the end point
-  const Vector3<S>& getVal() const;
+  /// @brief the value of the end point, a copy of the cached AABB bound
+  S value;
 
-  /// @brief set the value of the end point
-  Vector3<S>& getVal();
+  /// @brief handle of the SAP interval
+  uint32 aabb;
 
-  S getVal(size_t i) const;
-
-  S& getVal(size_t i);
-
-};
-
-/// @brief A pair of objects that are not culling away and should further check collision
-template <typename S>
-struct SaPCollisionManager<S>::SaPPair
-{
-  SaPPair(CollisionObject<S>* a, CollisionObject<S>* b);
-
-  CollisionObject<S>* obj1;
-  CollisionObject<S>* obj2;
-
-  bool operator == (const SaPPair& other) const;
-};
-
-/// @brief Functor to help unregister one object
-template <typename S>
-class FCL_EXPORT SaPCollisionManager<S>::isUnregistered
-{
-  CollisionObject<S>* obj;
-
-public:
-  isUnregistered(CollisionObject<S>* obj_);
-
-  bool operator() (const SaPPair& pair) const;
-};
-
-/// @brief Functor to help remove collision pairs no longer valid (i.e., should be culled away)
-template <typename S>
-class FCL_EXPORT SaPCollisionManager<S>::isNotValidPair
-{
-  CollisionObject<S>* obj1;
-  CollisionObject<S>* obj2;
-
-public:
-  isNotValidPair(CollisionObject<S>* obj1_, CollisionObject<S>* obj2_);
-
-  bool operator() (const SaPPair& pair);
+  /// @brief tag for whether it is a lower bound or higher bound of an interval, 0 for lo, and 1 for hi
+  char minmax;
 };
 
 } // namespace fcl
@@ -0,0 +1,585 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROAD_PHASE_BATCH_SAP_INL_H
+#define FCL_BROAD_PHASE_BATCH_SAP_INL_H
+
+#include "fcl/broadphase/broadphase_batch_SaP.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "fcl/common/detail/radix_sort.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT BatchSaPCollisionManager<double>;
+
+//==============================================================================
+template <typename S>
+BatchSaPCollisionManager<S>::BatchSaPCollisionManager()
+  : sweep_chunks_per_thread(8), cell_size_scale(4), axis(0),
+    position_lower(0), position_scale(0), position_bits(32), setup_(false)
+{
+  grid_axes[0] = 1;
+  grid_axes[1] = 2;
+  for(size_t i = 0; i < 2; ++i)
+  {
+    grid_lower[i] = 0;
+    grid_inv_cell_size[i] = 0;
+    grid_size[i] = 1;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::registerObjects(const std::vector<CollisionObject<S>*>& other_objs)
+{
+  objs.insert(objs.end(), other_objs.begin(), other_objs.end());
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::registerObject(CollisionObject<S>* obj)
+{
+  objs.push_back(obj);
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::unregisterObject(CollisionObject<S>* obj)
+{
+  auto it = std::find(objs.begin(), objs.end(), obj);
+  if(it == objs.end())
+    return;
+
+  objs.erase(it);
+
+  // the indices of the sorted entries and pairs are no longer valid
+  aabbs.clear();
+  keys.clear();
+  order.clear();
+  sorted_aabbs.clear();
+  cell_begins.assign(2, 0);
+  chunk_pairs.clear();
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::setup()
+{
+  if(setup_)
+    return;
+
+  const std::size_t n = objs.size();
+  ThreadPool* pool = (sweep_pool && sweep_pool->getNumThreads() > 1)
+      ? sweep_pool.get() : nullptr;
+  const std::size_t num_threads = pool ? pool->getNumThreads() : 1;
+
+  // Runs function(block, begin, end) over one block of [0, size) per thread
+  const std::size_t num_blocks = num_threads;
+  auto forEachBlock = [&](std::size_t size, const std::function<void(std::size_t, std::size_t, std::size_t)>& function)
+  {
+    auto run = [&](std::size_t block)
+    {
+      function(block, size * block / num_blocks, size * (block + 1) / num_blocks);
+    };
+
+    if(pool)
+      parallelFor(*pool, 0, num_blocks, run);
+    else
+      run(0);
+  };
+
+  // Gather the AABBs with their bounds, the spread of their centers and their
+  // average extents
+  aabbs.resize(n);
+  std::vector<AABB<S>> bounds(num_blocks);
+  std::vector<Vector3<S>> sums(num_blocks, Vector3<S>::Zero());
+  std::vector<Vector3<S>> square_sums(num_blocks, Vector3<S>::Zero());
+  std::vector<Vector3<S>> extent_sums(num_blocks, Vector3<S>::Zero());
+  forEachBlock(n, [&](std::size_t block, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const AABB<S>& aabb = objs[i]->getAABB();
+      aabbs[i] = aabb;
+      bounds[block] += aabb;
+      const Vector3<S> center = aabb.center();
+      sums[block] += center;
+      square_sums[block] += center.cwiseProduct(center);
+      extent_sums[block] += aabb.max_ - aabb.min_;
+    }
+  });
+
+  AABB<S> bound;
+  Vector3<S> sum = Vector3<S>::Zero();
+  Vector3<S> square_sum = Vector3<S>::Zero();
+  Vector3<S> extent_sum = Vector3<S>::Zero();
+  for(std::size_t block = 0; block < num_blocks; ++block)
+  {
+    bound += bounds[block];
+    sum += sums[block];
+    square_sum += square_sums[block];
+    extent_sum += extent_sums[block];
+  }
+
+  // n times the variance of the centers
+  const S num_objs = static_cast<S>(std::max<std::size_t>(n, 1));
+  const Vector3<S> spread = square_sum - sum.cwiseProduct(sum) / num_objs;
+  axis = 0;
+  if(spread[axis] < spread[1]) axis = 1;
+  if(spread[axis] < spread[2]) axis = 2;
+  grid_axes[0] = (axis + 1) % 3;
+  grid_axes[1] = (axis + 2) % 3;
+
+  // Cells a few average AABBs wide, keeping on average a few AABBs per cell,
+  // and at most 2^14 cells so that the keys keep 18 bits for the positions
+  const std::size_t max_grid_size = 128;
+  for(std::size_t i = 0; i < 2; ++i)
+  {
+    const size_t k = grid_axes[i];
+    const S width = (n > 0) ? bound.max_[k] - bound.min_[k] : 0;
+    const S cell_width = cell_size_scale * extent_sum[k] / num_objs;
+    grid_size[i] = 1;
+    if(width > 0 && cell_width > 0)
+      grid_size[i] = static_cast<std::size_t>(
+            std::min<S>(width / cell_width, max_grid_size)) + 1;
+  }
+  while(grid_size[0] * grid_size[1] > n / 4 + 1)
+  {
+    const std::size_t i = (grid_size[0] < grid_size[1]) ? 1 : 0;
+    grid_size[i] = (grid_size[i] + 1) / 2;
+  }
+  for(std::size_t i = 0; i < 2; ++i)
+  {
+    const size_t k = grid_axes[i];
+    grid_lower[i] = (n > 0) ? bound.min_[k] : 0;
+    const S width = (n > 0) ? bound.max_[k] - bound.min_[k] : 0;
+    grid_inv_cell_size[i] = (width > 0) ? grid_size[i] / width : 0;
+  }
+
+  const std::size_t num_cells = grid_size[0] * grid_size[1];
+  std::size_t cell_bits = 0;
+  while((static_cast<std::size_t>(1) << cell_bits) < num_cells)
+    ++cell_bits;
+
+  position_bits = 32 - cell_bits;
+  position_lower = (n > 0) ? bound.min_[axis] : 0;
+  const S length = (n > 0) ? bound.max_[axis] - bound.min_[axis] : 0;
+  position_scale = (length > 0)
+      ? ((static_cast<uint64>(1) << position_bits) - 1) / length : 0;
+
+  // Count the entries of the objects, one per cell they overlap
+  std::vector<std::size_t> block_entries(num_blocks + 1, 0);
+  forEachBlock(n, [&](std::size_t block, std::size_t begin, std::size_t end)
+  {
+    std::size_t count = 0;
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const AABB<S>& aabb = aabbs[i];
+      count += (getCell(aabb.max_[grid_axes[0]], 0) - getCell(aabb.min_[grid_axes[0]], 0) + 1)
+          * (getCell(aabb.max_[grid_axes[1]], 1) - getCell(aabb.min_[grid_axes[1]], 1) + 1);
+    }
+    block_entries[block + 1] = count;
+  });
+
+  for(std::size_t block = 0; block < num_blocks; ++block)
+    block_entries[block + 1] += block_entries[block];
+
+  // Key the entries by cell and lower bound, and sort them
+  const std::size_t num_entries = block_entries[num_blocks];
+  keys.resize(num_entries);
+  order.resize(num_entries);
+  forEachBlock(n, [&](std::size_t block, std::size_t begin, std::size_t end)
+  {
+    std::size_t entry = block_entries[block];
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const AABB<S>& aabb = aabbs[i];
+      const uint32 position = getPosition(aabb.min_[axis]);
+      const std::size_t lo[2] = {getCell(aabb.min_[grid_axes[0]], 0),
+                                 getCell(aabb.min_[grid_axes[1]], 1)};
+      const std::size_t hi[2] = {getCell(aabb.max_[grid_axes[0]], 0),
+                                 getCell(aabb.max_[grid_axes[1]], 1)};
+      for(std::size_t c0 = lo[0]; c0 <= hi[0]; ++c0)
+      {
+        for(std::size_t c1 = lo[1]; c1 <= hi[1]; ++c1)
+        {
+          keys[entry] = (static_cast<uint32>(c0 * grid_size[1] + c1) << position_bits) | position;
+          order[entry] = static_cast<uint32>(i);
+          ++entry;
+        }
+      }
+    }
+  });
+
+  detail::radixSort(keys, order, 32, pool);
+
+  // Find where the cells start, and copy the AABBs next to each other
+  cell_begins.assign(num_cells + 1, num_entries);
+  sorted_aabbs.resize(num_entries);
+  forEachBlock(num_entries, [&](std::size_t, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const std::size_t cell = getCellOfKey(keys[i]);
+      if(i == 0 || cell != getCellOfKey(keys[i - 1]))
+        cell_begins[cell] = i;
+      sorted_aabbs[i] = aabbs[order[i]];
+    }
+  });
+
+  // empty cells start where the next cell does
+  for(std::size_t cell = num_cells; cell-- > 0;)
+    cell_begins[cell] = std::min(cell_begins[cell], cell_begins[cell + 1]);
+
+  // Sweep
+  const std::size_t num_chunks = std::min(
+        pool ? num_threads * std::max<std::size_t>(sweep_chunks_per_thread, 1) : 1,
+        std::max<std::size_t>(num_entries, 1));
+  chunk_pairs.resize(num_chunks);
+
+  if(pool)
+    parallelFor(*pool, 0, num_chunks, [this](std::size_t chunk) { sweep(chunk); });
+  else
+    sweep(0);
+
+  setup_ = true;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::sweep(std::size_t chunk)
+{
+  const std::size_t num_entries = keys.size();
+  const std::size_t num_chunks = chunk_pairs.size();
+  const std::size_t begin = num_entries * chunk / num_chunks;
+  const std::size_t end = num_entries * (chunk + 1) / num_chunks;
+
+  std::vector<std::pair<uint32, uint32>>& pairs = chunk_pairs[chunk];
+  pairs.clear();
+
+  for(std::size_t i = begin; i < end; ++i)
+  {
+    const AABB<S>& aabb = sorted_aabbs[i];
+    const std::size_t cell = getCellOfKey(keys[i]);
+
+    // the entries after i in its cell whose position is not larger than the
+    // position of the upper bound of i are the only ones that may overlap it
+    // along axis
+    const uint32 max_key = ((keys[i] >> position_bits) << position_bits)
+        | getPosition(aabb.max_[axis]);
+    const std::size_t cell_end = cell_begins[cell + 1];
+    for(std::size_t j = i + 1; j < cell_end && keys[j] <= max_key; ++j)
+    {
+      if(aabb.overlap(sorted_aabbs[j])
+         && getOverlapCell(aabb, sorted_aabbs[j]) == cell)
+        pairs.emplace_back(order[i], order[j]);
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+uint32 BatchSaPCollisionManager<S>::getPosition(S value) const
+{
+  const S position = (value - position_lower) * position_scale;
+  if(!(position > 0))
+    return 0;
+
+  const uint32 max_position = static_cast<uint32>(
+        (static_cast<uint64>(1) << position_bits) - 1);
+  if(position >= max_position)
+    return max_position;
+
+  return static_cast<uint32>(position);
+}
+
+//==============================================================================
+template <typename S>
+size_t BatchSaPCollisionManager<S>::getCell(S value, size_t i) const
+{
+  const S cell = (value - grid_lower[i]) * grid_inv_cell_size[i];
+  if(!(cell > 0))
+    return 0;
+  if(cell >= grid_size[i])
+    return grid_size[i] - 1;
+  return static_cast<size_t>(cell);
+}
+
+//==============================================================================
+template <typename S>
+size_t BatchSaPCollisionManager<S>::getOverlapCell(const AABB<S>& a, const AABB<S>& b) const
+{
+  const size_t k0 = grid_axes[0];
+  const size_t k1 = grid_axes[1];
+  return getCell(std::max(a.min_[k0], b.min_[k0]), 0) * grid_size[1]
+      + getCell(std::max(a.min_[k1], b.min_[k1]), 1);
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::update()
+{
+  setup_ = false;
+  setup();
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::clear()
+{
+  objs.clear();
+  aabbs.clear();
+  keys.clear();
+  order.clear();
+  sorted_aabbs.clear();
+  cell_begins.assign(2, 0);
+  chunk_pairs.clear();
+  setup_ = false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::getObjects(std::vector<CollisionObject<S>*>& objs_) const
+{
+  objs_ = objs;
+}
+
+//==============================================================================
+template <typename S>
+bool BatchSaPCollisionManager<S>::collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(keys.empty())
+    return false;
+
+  const AABB<S>& obj_aabb = obj->getAABB();
+  const uint32 max_position = getPosition(obj_aabb.max_[axis]);
+
+  // The query goes in the cells it overlaps; as for the pairs of the sweep,
+  // an object is reported by the cell holding the lower corner of the overlap
+  const size_t lo[2] = {getCell(obj_aabb.min_[grid_axes[0]], 0),
+                        getCell(obj_aabb.min_[grid_axes[1]], 1)};
+  const size_t hi[2] = {getCell(obj_aabb.max_[grid_axes[0]], 0),
+                        getCell(obj_aabb.max_[grid_axes[1]], 1)};
+  for(size_t c0 = lo[0]; c0 <= hi[0]; ++c0)
+  {
+    for(size_t c1 = lo[1]; c1 <= hi[1]; ++c1)
+    {
+      const size_t cell = c0 * grid_size[1] + c1;
+      const uint32 cell_max_key = (static_cast<uint32>(cell) << position_bits) | max_position;
+      for(size_t k = cell_begins[cell];
+          k < cell_begins[cell + 1] && keys[k] <= cell_max_key; ++k)
+      {
+        const AABB<S>& aabb = sorted_aabbs[k];
+        if(aabb.overlap(obj_aabb) && getOverlapCell(aabb, obj_aabb) == cell)
+        {
+          CollisionObject<S>* other = objs[order[k]];
+          if(other != obj && callback(obj, other, cdata))
+            return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+
+  collide_(obj, cdata, callback);
+}
+
+//==============================================================================
+template <typename S>
+bool BatchSaPCollisionManager<S>::distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const
+{
+  const AABB<S>& obj_aabb = obj->getAABB();
+
+  for(size_t i = 0; i < aabbs.size(); ++i)
+  {
+    CollisionObject<S>* other = objs[i];
+    if(other != obj && aabbs[i].distance(obj_aabb) < min_dist)
+    {
+      if(callback(other, obj, cdata, min_dist))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  distance_(obj, cdata, callback, min_dist);
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::collide(void* cdata, CollisionCallBack<S> callback) const
+{
+  if(size() == 0) return;
+
+  for(const auto& pairs : chunk_pairs)
+  {
+    for(const auto& pair : pairs)
+    {
+      if(callback(objs[pair.first], objs[pair.second], cdata))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::distance(void* cdata, DistanceCallBack<S> callback) const
+{
+  if(size() == 0) return;
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  for(size_t i = 0; i < aabbs.size(); ++i)
+  {
+    for(size_t j = i + 1; j < aabbs.size(); ++j)
+    {
+      if(aabbs[i].distance(aabbs[j]) < min_dist)
+      {
+        if(callback(objs[i], objs[j], cdata, min_dist))
+          return;
+      }
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::collide(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, CollisionCallBack<S> callback) const
+{
+  BatchSaPCollisionManager* other_manager = static_cast<BatchSaPCollisionManager*>(other_manager_);
+
+  if((size() == 0) || (other_manager->size() == 0)) return;
+
+  if(this == other_manager)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  if(this->size() < other_manager->size())
+  {
+    for(CollisionObject<S>* obj : objs)
+    {
+      if(other_manager->collide_(obj, cdata, callback))
+        return;
+    }
+  }
+  else
+  {
+    for(CollisionObject<S>* obj : other_manager->objs)
+    {
+      if(collide_(obj, cdata, callback))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void BatchSaPCollisionManager<S>::distance(BroadPhaseCollisionManager<S>* other_manager_, void* cdata, DistanceCallBack<S> callback) const
+{
+  BatchSaPCollisionManager* other_manager = static_cast<BatchSaPCollisionManager*>(other_manager_);
+
+  if((size() == 0) || (other_manager->size() == 0)) return;
+
+  if(this == other_manager)
+  {
+    distance(cdata, callback);
+    return;
+  }
+
+  S min_dist = std::numeric_limits<S>::max();
+
+  if(this->size() < other_manager->size())
+  {
+    for(CollisionObject<S>* obj : objs)
+    {
+      if(other_manager->distance_(obj, cdata, callback, min_dist))
+        return;
+    }
+  }
+  else
+  {
+    for(CollisionObject<S>* obj : other_manager->objs)
+    {
+      if(distance_(obj, cdata, callback, min_dist))
+        return;
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+bool BatchSaPCollisionManager<S>::empty() const
+{
+  return objs.empty();
+}
+
+//==============================================================================
+template <typename S>
+size_t BatchSaPCollisionManager<S>::size() const
+{
+  return objs.size();
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROAD_PHASE_BATCH_SAP_H
+#define FCL_BROAD_PHASE_BATCH_SAP_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "fcl/broadphase/broadphase_collision_manager.h"
+#include "fcl/common/thread_pool.h"
+
+namespace fcl
+{
+
+/// @brief Sweep and prune collision manager for scenes that are built again
+/// every frame, such as boxes fitted to a point cloud. setup() and update()
+/// compute all the overlapping pairs from scratch:
+/// - the sweep axis is the one along which the centers of the AABBs spread
+///   most, and the two other axes are cut into a grid of cells a few AABBs
+///   wide, each AABB going in every cell it overlaps;
+/// - the entries are radix sorted on 32 bit keys, holding the cell and the
+///   lower bound along the sweep axis rounded down to a fixed point position
+///   within the bounds of the scene;
+/// - the sorted entries are split into chunks, each sweeping its entries
+///   against the following ones of the same cell. A pair is reported by the
+///   cell holding the lower corner of the overlap of the two AABBs only.
+///
+/// Sweeping per cell keeps the number of candidates low when many AABBs
+/// project onto the same stretch of the sweep axis. With a pool, the sort and
+/// the chunks run on its threads and each chunk writes its pairs to its own
+/// buffer, so the pairs come in the same order with or without a pool.
+template <typename S>
+class FCL_EXPORT BatchSaPCollisionManager : public BroadPhaseCollisionManager<S>
+{
+public:
+
+  /// @brief if not null, setup() and update() sort and sweep on the threads
+  /// of this pool
+  std::shared_ptr<ThreadPool> sweep_pool;
+
+  /// @brief the sweep splits the sorted entries into about this many chunks
+  /// per thread of the pool, so that idle threads can take over the chunks
+  /// with many overlaps
+  std::size_t sweep_chunks_per_thread;
+
+  /// @brief the cells of the grid are about this many times as wide as the
+  /// average AABB
+  S cell_size_scale;
+
+  BatchSaPCollisionManager();
+
+  /// @brief add objects to the manager
+  void registerObjects(const std::vector<CollisionObject<S>*>& other_objs);
+
+  /// @brief add one object to the manager
+  void registerObject(CollisionObject<S>* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(CollisionObject<S>* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager
+  void update();
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<CollisionObject<S>*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects belonging to the manager
+  void collide(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance computation between one object and all the objects belonging to the manager.
+  /// The distance queries go through all the objects, pruned by the distance
+  /// of the AABBs only.
+  void distance(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager
+  /// (i.e., N^2 self collision). The pairs are the ones found by the last
+  /// setup() or update(), delivered in the order of the sweep.
+  void collide(void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
+  void distance(void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseCollisionManager<S>* other_manager, void* cdata, CollisionCallBack<S> callback) const;
+
+  /// @brief perform distance test with objects belonging to another manager
+  void distance(BroadPhaseCollisionManager<S>* other_manager, void* cdata, DistanceCallBack<S> callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+protected:
+
+  /// @brief The fixed point position of value along axis. Rounding down keeps
+  /// the order, so a larger position means a larger value.
+  uint32 getPosition(S value) const;
+
+  /// @brief The grid coordinate along the i-th grid axis of value; clamped
+  /// to the grid, so that any value falls in a cell
+  size_t getCell(S value, size_t i) const;
+
+  /// @brief The cell holding the lower corner of the overlap of two AABBs
+  size_t getOverlapCell(const AABB<S>& a, const AABB<S>& b) const;
+
+  /// @brief Find the overlapping pairs of the entries of one chunk with the
+  /// entries that follow them in the same cell
+  void sweep(std::size_t chunk);
+
+  bool collide_(CollisionObject<S>* obj, void* cdata, CollisionCallBack<S> callback) const;
+
+  bool distance_(CollisionObject<S>* obj, void* cdata, DistanceCallBack<S> callback, S& min_dist) const;
+
+  /// @brief Objects in the order of registration
+  std::vector<CollisionObject<S>*> objs;
+
+  /// @brief AABBs of the objects, in the order of registration
+  std::vector<AABB<S>> aabbs;
+
+  /// @brief The axis of the sweep
+  size_t axis;
+
+  /// @brief The two other axes, cut into the grid
+  size_t grid_axes[2];
+
+  /// @brief The lowest bounds of the AABBs along the grid axes
+  S grid_lower[2];
+
+  /// @brief The inverse of the cell widths along the grid axes
+  S grid_inv_cell_size[2];
+
+  /// @brief The number of cells along the grid axes
+  size_t grid_size[2];
+
+  /// @brief The lowest bound of the AABBs along axis
+  S position_lower;
+
+  /// @brief The number of fixed point positions per unit of length along axis
+  S position_scale;
+
+  /// @brief The number of bits of the fixed point positions
+  size_t position_bits;
+
+  /// @brief Keys of the entries, sorted: the cell in the upper bits and the
+  /// position of the lower bound along axis in the lower position_bits bits
+  std::vector<uint32> keys;
+
+  /// @brief Indices in objs of the objects of the sorted entries
+  std::vector<uint32> order;
+
+  /// @brief AABBs of the objects of the sorted entries
+  std::vector<AABB<S>> sorted_aabbs;
+
+  /// @brief The first entry of every cell, and the number of entries last
+  std::vector<size_t> cell_begins;
+
+  /// @brief Overlapping pairs of indices in objs, one buffer per chunk
+  std::vector<std::vector<std::pair<uint32, uint32>>> chunk_pairs;
+
+  /// @brief tag about whether the sorted entries and the pairs are up to date
+  bool setup_;
+};
+
+using BatchSaPCollisionManagerf = BatchSaPCollisionManager<float>;
+using BatchSaPCollisionManagerd = BatchSaPCollisionManager<double>;
+
+} // namespace fcl
+
+#include "fcl/broadphase/broadphase_batch_SaP-inl.h"
+
+#endif
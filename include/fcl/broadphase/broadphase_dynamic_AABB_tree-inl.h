@@ -40,7 +40,11 @@
 
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
 #include <limits>
+#include <mutex>
 
 #if FCL_HAVE_OCTOMAP
 #include "fcl/geometry/octree/octree.h"
@@ -719,6 +723,206 @@ bool selfDistanceRecurse(typename DynamicAABBTreeCollisionManager<S>::DynamicAAB
   return false;
 }
 
+//==============================================================================
+/// @brief A piece of the self collision traversal: the self collision of the
+/// subtree at root1 if root2 is null, otherwise the collision between the
+/// subtrees at root1 and root2
+template <typename S>
+struct SelfCollisionTask
+{
+  typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root1;
+  typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root2;
+};
+
+//==============================================================================
+/// @brief Unroll the top of selfCollisionRecurse() into at least max_tasks
+/// independent tasks when the tree allows it. Running the tasks in order
+/// reports the pairs in the same order as selfCollisionRecurse(root, ...).
+template <typename S>
+FCL_EXPORT
+void splitSelfCollision(
+    typename DynamicAABBTreeCollisionManager<S>::DynamicAABBNode* root,
+    std::size_t max_tasks,
+    std::vector<SelfCollisionTask<S>>& tasks)
+{
+  tasks.clear();
+  tasks.push_back({root, nullptr});
+
+  std::vector<SelfCollisionTask<S>> next_tasks;
+  bool split = true;
+  while(split && tasks.size() < max_tasks)
+  {
+    split = false;
+    next_tasks.clear();
+
+    for(const auto& task : tasks)
+    {
+      auto* root1 = task.root1;
+      auto* root2 = task.root2;
+
+      if(!root2)
+      {
+        if(root1->isLeaf()) continue;
+
+        next_tasks.push_back({root1->children[0], nullptr});
+        next_tasks.push_back({root1->children[1], nullptr});
+        next_tasks.push_back({root1->children[0], root1->children[1]});
+        split = true;
+      }
+      else if(!root1->bv.overlap(root2->bv))
+      {
+        continue;
+      }
+      else if(root1->isLeaf() && root2->isLeaf())
+      {
+        next_tasks.push_back(task);
+      }
+      else if(root2->isLeaf() || (!root1->isLeaf() && (root1->bv.size() > root2->bv.size())))
+      {
+        next_tasks.push_back({root1->children[0], root2});
+        next_tasks.push_back({root1->children[1], root2});
+        split = true;
+      }
+      else
+      {
+        next_tasks.push_back({root1, root2->children[0]});
+        next_tasks.push_back({root1, root2->children[1]});
+        split = true;
+      }
+    }
+
+    tasks.swap(next_tasks);
+  }
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool runSelfCollisionTask(
+    const SelfCollisionTask<S>& task, void* cdata, CollisionCallBack<S> callback)
+{
+  if(task.root2)
+    return collisionRecurse(task.root1, task.root2, cdata, callback);
+  else
+    return selfCollisionRecurse(task.root1, cdata, callback);
+}
+
+//==============================================================================
+/// @brief The pairs found by one task of the ordered parallel self collision
+template <typename S>
+struct OrderedCollisionBuffer
+{
+  std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  const std::atomic<bool>* stopped;
+};
+
+//==============================================================================
+/// @brief Collision callback appending the pair to the
+/// OrderedCollisionBuffer in cdata, which stops the traversal once the pairs
+/// delivered so far made the user callback return true
+template <typename S>
+FCL_EXPORT
+bool collectOrderedCollisionPair(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata)
+{
+  auto* buffer = static_cast<OrderedCollisionBuffer<S>*>(cdata);
+  if(buffer->stopped->load(std::memory_order_relaxed))
+    return true;
+
+  buffer->pairs.emplace_back(o1, o2);
+  return false;
+}
+
+//==============================================================================
+/// @brief The state shared by the threads of the ordered parallel self
+/// collision: the task buffers, the next task to claim, which tasks finished
+/// and whether the query stopped
+template <typename S>
+struct OrderedCollisionData
+{
+  explicit OrderedCollisionData(std::size_t num_tasks)
+    : buffers(num_tasks), finished(num_tasks, false), next_task(0), stopped(false)
+  {
+    for(auto& buffer : buffers)
+      buffer.stopped = &stopped;
+  }
+
+  /// @brief Claim the next task in traversal order, if any is left
+  bool claim(std::size_t& task)
+  {
+    if(stopped.load(std::memory_order_relaxed))
+      return false;
+
+    task = next_task++;
+    return task < buffers.size();
+  }
+
+  void finish(std::size_t task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished[task] = true;
+    }
+    finished_cv.notify_all();
+  }
+
+  bool isFinished(std::size_t task)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finished[task];
+  }
+
+  void waitFinished(std::size_t task)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished_cv.wait(lock, [&]() { return static_cast<bool>(finished[task]); });
+  }
+
+  void stop()
+  {
+    stopped.store(true, std::memory_order_relaxed);
+  }
+
+  std::vector<OrderedCollisionBuffer<S>> buffers;
+  std::vector<bool> finished;
+  std::atomic<std::size_t> next_task;
+  std::atomic<bool> stopped;
+  std::mutex mutex;
+  std::condition_variable finished_cv;
+};
+
+//==============================================================================
+/// @brief The data of concurrentCollisionCallback(): the user callback, the
+/// user data of the calling thread and the flag shared by all threads that is
+/// raised once any of them may stop
+template <typename S>
+struct ConcurrentCollisionData
+{
+  CollisionCallBack<S> callback;
+  void* cdata;
+  std::atomic<bool>* done;
+};
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool concurrentCollisionCallback(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<ConcurrentCollisionData<S>*>(cdata_);
+
+  if(cdata->done->load(std::memory_order_relaxed))
+    return true;
+
+  if(cdata->callback(o1, o2, cdata->cdata))
+  {
+    cdata->done->store(true, std::memory_order_relaxed);
+    return true;
+  }
+
+  return false;
+}
+
 } // namespace dynamic_AABB_tree
 
 } // namespace detail
@@ -735,6 +939,7 @@ DynamicAABBTreeCollisionManager<S>::DynamicAABBTreeCollisionManager()
   tree_topdown_balance_threshold = 2;
   tree_topdown_level = 0;
   tree_init_level = 0;
+  parallel_tasks_per_thread = 16;
   setup_ = false;
 
   // from experiment, this is the optimal setting
@@ -952,6 +1157,123 @@ void DynamicAABBTreeCollisionManager<S>::collide(void* cdata, CollisionCallBack<
   detail::dynamic_AABB_tree::selfCollisionRecurse(dtree.getRoot(), cdata, callback);
 }
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void DynamicAABBTreeCollisionManager<S>::collide(
+    void* cdata, CollisionCallBack<S> callback, ThreadPool& pool) const
+{
+  if(size() == 0) return;
+  if(pool.getNumThreads() == 1)
+  {
+    collide(cdata, callback);
+    return;
+  }
+
+  std::vector<detail::dynamic_AABB_tree::SelfCollisionTask<S>> tasks;
+  detail::dynamic_AABB_tree::splitSelfCollision<S>(
+        dtree.getRoot(), parallel_tasks_per_thread * pool.getNumThreads(), tasks);
+
+  // Tasks are claimed in traversal order. The calling thread delivers the
+  // pairs of each task as soon as it and all the earlier ones finished, and
+  // runs tasks itself while the next one to deliver is still in progress.
+  // Once the callback returns true, the traversals still running stop and no
+  // further task is started.
+  detail::dynamic_AABB_tree::OrderedCollisionData<S> data(tasks.size());
+
+  auto runTasks = [&]()
+  {
+    std::size_t i;
+    while(data.claim(i))
+    {
+      detail::dynamic_AABB_tree::runSelfCollisionTask<S>(
+            tasks[i], &data.buffers[i],
+            detail::dynamic_AABB_tree::collectOrderedCollisionPair<S>);
+      data.finish(i);
+    }
+  };
+
+  TaskGroup group(pool);
+  for(std::size_t i = 1; i < pool.getNumThreads(); ++i)
+    group.run(runTasks);
+
+  for(std::size_t next = 0; next < tasks.size(); ++next)
+  {
+    std::size_t i;
+    while(!data.isFinished(next))
+    {
+      if(data.claim(i))
+      {
+        detail::dynamic_AABB_tree::runSelfCollisionTask<S>(
+              tasks[i], &data.buffers[i],
+              detail::dynamic_AABB_tree::collectOrderedCollisionPair<S>);
+        data.finish(i);
+      }
+      else
+      {
+        data.waitFinished(next);
+      }
+    }
+
+    for(const auto& pair : data.buffers[next].pairs)
+    {
+      if(callback(pair.first, pair.second, cdata))
+      {
+        data.stop();
+        group.wait();
+        return;
+      }
+    }
+  }
+
+  group.wait();
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void DynamicAABBTreeCollisionManager<S>::collide(
+    const std::vector<void*>& cdata,
+    CollisionCallBack<S> callback,
+    ThreadPool& pool) const
+{
+  if(cdata.size() != pool.getNumThreads())
+  {
+    std::cerr << "Warning: collide() needs one cdata entry per thread of the pool, got "
+              << cdata.size() << " for " << pool.getNumThreads()
+              << " threads. The query was ignored." << std::endl;
+    return;
+  }
+
+  if(size() == 0) return;
+  if(pool.getNumThreads() == 1)
+  {
+    collide(cdata[0], callback);
+    return;
+  }
+
+  std::vector<detail::dynamic_AABB_tree::SelfCollisionTask<S>> tasks;
+  detail::dynamic_AABB_tree::splitSelfCollision<S>(
+        dtree.getRoot(), parallel_tasks_per_thread * pool.getNumThreads(), tasks);
+
+  std::atomic<bool> done(false);
+  std::vector<detail::dynamic_AABB_tree::ConcurrentCollisionData<S>> thread_data(cdata.size());
+  for(std::size_t i = 0; i < cdata.size(); ++i)
+  {
+    thread_data[i].callback = callback;
+    thread_data[i].cdata = cdata[i];
+    thread_data[i].done = &done;
+  }
+
+  parallelFor(pool, 0, tasks.size(), [&](std::size_t i)
+  {
+    if(done.load(std::memory_order_relaxed)) return;
+    detail::dynamic_AABB_tree::runSelfCollisionTask<S>(
+          tasks[i], &thread_data[pool.getThreadIndex()],
+          detail::dynamic_AABB_tree::concurrentCollisionCallback<S>);
+  });
+}
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
@@ -41,6 +41,7 @@
 #include <unordered_map>
 #include <functional>
 
+#include "fcl/common/thread_pool.h"
 #include "fcl/math/bv/utility.h"
 #include "fcl/geometry/shape/box.h"
 #include "fcl/geometry/shape/utility.h"
@@ -64,6 +65,10 @@ public:
   int& tree_topdown_level;
   int tree_init_level;
 
+  /// @brief the parallel queries split the traversal into about this many
+  /// tasks per thread of the pool, so that idle threads can steal work
+  std::size_t parallel_tasks_per_thread;
+
   bool octree_as_geometry_collide;
   bool octree_as_geometry_distance;
 
@@ -105,6 +110,23 @@ public:
   /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
   void collide(void* cdata, CollisionCallBack<S> callback) const;
 
+  /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
+  /// on the threads of pool. The candidate pairs are gathered in parallel and
+  /// the callback is called on the calling thread, in the same order as the
+  /// serial version, so it needs no synchronization. Once the callback returns
+  /// true no further pairs are gathered, but the traversal may have run
+  /// ahead of the delivered pairs by up to one task per thread, so a query
+  /// that stops at the first hit does more work than the serial version.
+  void collide(void* cdata, CollisionCallBack<S> callback, ThreadPool& pool) const;
+
+  /// @brief perform collision test for the objects belonging to the manager (i.e., N^2 self collision)
+  /// on the threads of pool, calling the callback from those threads. cdata
+  /// holds one entry per thread of the pool and each call gets the entry of
+  /// the thread it runs on, so per-thread results need no locking. The test
+  /// stops once any call returns true. If cdata does not have exactly
+  /// pool.getNumThreads() entries, a warning is printed and nothing is done.
+  void collide(const std::vector<void*>& cdata, CollisionCallBack<S> callback, ThreadPool& pool) const;
+
   /// @brief perform distance test for the objects belonging to the manager (i.e., N^2 self distance)
   void distance(void* cdata, DistanceCallBack<S> callback) const;
 
@@ -0,0 +1,111 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BROADPHASE_DETAIL_PAIRHASHSET_H
+#define FCL_BROADPHASE_DETAIL_PAIRHASHSET_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "fcl/common/types.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Set of unordered pairs of integer handles. The pairs are kept in a
+/// dense array, so iterating over them touches contiguous memory, and are
+/// found through an open-addressing hash table with linear probing, so
+/// inserting, erasing and finding a pair does not allocate once the table is
+/// large enough.
+class FCL_EXPORT PairHashSet
+{
+public:
+  /// @brief pair of handles, with first < second
+  using Pair = std::pair<uint32, uint32>;
+
+  PairHashSet();
+
+  /// @brief Add the pair {a, b}; returns false if it was already there
+  bool insert(uint32 a, uint32 b);
+
+  /// @brief Remove the pair {a, b}; returns false if it was not there
+  bool erase(uint32 a, uint32 b);
+
+  /// @brief Remove all the pairs with a
+  void eraseAll(uint32 a);
+
+  /// @brief Whether the pair {a, b} is in the set
+  bool contains(uint32 a, uint32 b) const;
+
+  /// @brief Remove all the pairs, keeping the memory
+  void clear();
+
+  /// @brief The number of pairs
+  std::size_t size() const;
+
+  /// @brief The pairs, in no particular order. Erasing a pair moves the last
+  /// one in its place.
+  const std::vector<Pair>& getPairs() const;
+
+private:
+  static Pair makePair(uint32 a, uint32 b);
+
+  /// @brief The slot of pair, or of the empty slot where it would go
+  std::size_t findSlot(const Pair& pair) const;
+
+  std::size_t getHomeSlot(const Pair& pair) const;
+
+  /// @brief Remove the entry in slot, moving the following entries of its
+  /// probe sequence back so that no tombstones are needed
+  void eraseSlot(std::size_t slot);
+
+  void rehash(std::size_t num_slots);
+
+  std::vector<Pair> pairs_;
+
+  /// @brief index + 1 of the pair in pairs_, 0 for empty slots; the number of
+  /// slots is a power of two
+  std::vector<uint32> slots_;
+
+  std::size_t shift_;
+};
+
+} // namespace detail
+} // namespace fcl
+
+#endif
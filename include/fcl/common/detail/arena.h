@@ -0,0 +1,140 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_ARENA_H
+#define FCL_COMMON_DETAIL_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "fcl/export.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Bump allocator for the scratch memory of a single query. Memory is
+/// handed out from blocks that are kept when it is given back, so once the
+/// blocks are large enough allocate() stops calling the system allocator.
+/// Single allocations are never freed: a Scope gives back everything allocated
+/// during its lifetime when it is destroyed. Not thread-safe; threadLocal()
+/// gives each thread its own arena.
+class FCL_EXPORT Arena
+{
+public:
+  // non-copyable
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// @brief Restores the position of an arena when destroyed, giving back the
+  /// memory allocated since it was created. Scopes on the same arena must be
+  /// destroyed in the reverse order of their creation.
+  class FCL_EXPORT Scope
+  {
+  public:
+    // non-copyable
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    explicit Scope(Arena& arena);
+
+    ~Scope();
+
+  private:
+    Arena& arena_;
+    std::size_t block_;
+    std::size_t offset_;
+  };
+
+  /// @brief Create an empty arena that allocates blocks of at least
+  /// block_size bytes
+  explicit Arena(std::size_t block_size = 65536);
+
+  /// @brief size bytes aligned to alignment, which must be a power of two
+  void* allocate(std::size_t size, std::size_t alignment);
+
+  /// @brief num default-constructed objects of type T, which must be
+  /// trivially destructible since their destructors are never called
+  template <typename T>
+  T* allocate(std::size_t num);
+
+  /// @brief Give back all the memory allocated so far, keeping the blocks
+  void reset();
+
+  /// @brief The number of bytes allocated so far that were not given back
+  std::size_t getUsed() const;
+
+  /// @brief The total size of the blocks
+  std::size_t getCapacity() const;
+
+  /// @brief The arena of the calling thread
+  static Arena& threadLocal();
+
+private:
+  struct Block
+  {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  std::size_t block_size_;
+
+  /// @brief The block being filled and the first free byte in it
+  std::size_t block_;
+  std::size_t offset_;
+};
+
+//==============================================================================
+template <typename T>
+T* Arena::allocate(std::size_t num)
+{
+  static_assert(std::is_trivially_destructible<T>::value,
+                "Arena does not call the destructors of the objects it holds");
+
+  T* objects = static_cast<T*>(allocate(sizeof(T) * num, alignof(T)));
+  for(std::size_t i = 0; i < num; ++i)
+    new (objects + i) T;
+
+  return objects;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_DETAIL_RADIXSORT_H
+#define FCL_COMMON_DETAIL_RADIXSORT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "fcl/common/thread_pool.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Stable LSD radix sort of values by their unsigned integer keys,
+/// keys being sorted along. Only the lowest num_bits bits of the keys are
+/// looked at, 8 bits per pass; passes in which every key has the same digit
+/// are skipped. If pool is not null, the keys are split into one block per
+/// thread and each pass counts and scatters the blocks in parallel.
+template <typename Key, typename Value>
+void radixSort(std::vector<Key>& keys,
+               std::vector<Value>& values,
+               std::size_t num_bits,
+               ThreadPool* pool = nullptr);
+
+//==============================================================================
+template <typename Key, typename Value>
+void radixSort(std::vector<Key>& keys,
+               std::vector<Value>& values,
+               std::size_t num_bits,
+               ThreadPool* pool)
+{
+  const std::size_t num_digits = 256;
+  const std::size_t n = keys.size();
+  if(n < 2)
+    return;
+
+  std::size_t num_blocks = 1;
+  if(pool && pool->getNumThreads() > 1 && n >= 4096)
+    num_blocks = pool->getNumThreads();
+  const std::size_t block_size = (n + num_blocks - 1) / num_blocks;
+
+  std::vector<Key> sorted_keys(n);
+  std::vector<Value> sorted_values(n);
+  std::vector<std::size_t> offsets(num_blocks * num_digits);
+
+  for(std::size_t shift = 0; shift < num_bits; shift += 8)
+  {
+    // Digit counts of every block
+    std::fill(offsets.begin(), offsets.end(), 0);
+    auto count = [&](std::size_t block)
+    {
+      std::size_t* block_offsets = &offsets[block * num_digits];
+      const std::size_t end = std::min(n, (block + 1) * block_size);
+      for(std::size_t i = block * block_size; i < end; ++i)
+        ++block_offsets[(keys[i] >> shift) & 0xff];
+    };
+
+    if(num_blocks > 1)
+      parallelFor(*pool, 0, num_blocks, count);
+    else
+      count(0);
+
+    // Turn the counts into the first output position of every digit of every
+    // block, block by block within each digit so that the sort is stable
+    bool skip = false;
+    std::size_t position = 0;
+    for(std::size_t digit = 0; digit < num_digits && !skip; ++digit)
+    {
+      const std::size_t digit_begin = position;
+      for(std::size_t block = 0; block < num_blocks; ++block)
+      {
+        const std::size_t c = offsets[block * num_digits + digit];
+        offsets[block * num_digits + digit] = position;
+        position += c;
+      }
+      skip = (position - digit_begin == n);
+    }
+
+    if(skip)
+      continue;
+
+    auto scatter = [&](std::size_t block)
+    {
+      std::size_t* block_offsets = &offsets[block * num_digits];
+      const std::size_t end = std::min(n, (block + 1) * block_size);
+      for(std::size_t i = block * block_size; i < end; ++i)
+      {
+        const std::size_t j = block_offsets[(keys[i] >> shift) & 0xff]++;
+        sorted_keys[j] = keys[i];
+        sorted_values[j] = values[i];
+      }
+    };
+
+    if(num_blocks > 1)
+      parallelFor(*pool, 0, num_blocks, scatter);
+    else
+      scatter(0);
+
+    keys.swap(sorted_keys);
+    values.swap(sorted_values);
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
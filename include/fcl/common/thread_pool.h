@@ -0,0 +1,195 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_COMMON_THREAD_POOL_H
+#define FCL_COMMON_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fcl/export.h"
+
+namespace fcl
+{
+
+class TaskGroup;
+
+/// @brief A fixed-size pool of worker threads with one task deque per thread.
+/// Each thread pushes and pops its own tasks at the back of its deque (LIFO,
+/// which keeps recursively spawned work cache-local) and steals from the front
+/// of the other deques when it runs out of work.
+///
+/// The thread that waits on a TaskGroup takes part in the work, so a pool
+/// created with num_threads = 1 has no worker threads and runs every task on
+/// the calling thread. Only one thread outside the pool should drive a given
+/// pool at a time.
+class FCL_EXPORT ThreadPool
+{
+public:
+  // non-copyable
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Create a pool that runs tasks on num_threads threads in total,
+  /// including the thread that waits for them. Zero means one thread per
+  /// hardware thread.
+  explicit ThreadPool(std::size_t num_threads = 0);
+
+  /// @brief Stop and join all worker threads. Tasks still queued are dropped.
+  ~ThreadPool();
+
+  /// @brief The number of threads that run tasks, including the calling one
+  std::size_t getNumThreads() const;
+
+  /// @brief The index in [0, getNumThreads()) of the thread calling this
+  /// function. Worker threads have indices [0, getNumThreads() - 1) and any
+  /// thread outside the pool gets getNumThreads() - 1. Useful for indexing
+  /// per-thread buffers from inside a task.
+  std::size_t getThreadIndex() const;
+
+private:
+  friend class TaskGroup;
+
+  struct Job
+  {
+    std::function<void()> function;
+    TaskGroup* group;
+  };
+
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::thread> threads_;
+
+  /// @brief One deque per worker thread plus one for threads outside the pool
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> num_queued_;
+  bool stop_;
+
+  void submit(Job job);
+
+  bool tryPop(std::size_t index, Job& job);
+
+  void execute(Job& job);
+
+  void workerLoop(std::size_t index);
+};
+
+/// @brief A set of tasks run on a ThreadPool that can be waited on together.
+/// Tasks may add further tasks to the group they belong to, which is how
+/// recursive divide-and-conquer work is spread over the pool.
+class FCL_EXPORT TaskGroup
+{
+public:
+  // non-copyable
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  explicit TaskGroup(ThreadPool& pool);
+
+  /// @brief Waits for the remaining tasks
+  ~TaskGroup();
+
+  /// @brief Schedule task to be run by some thread of the pool
+  void run(std::function<void()> task);
+
+  /// @brief Block until every task of the group finished, running queued
+  /// tasks on the calling thread in the meantime and sleeping while there are
+  /// none. Rethrows the first exception thrown by a task, if any.
+  void wait();
+
+  /// @brief The pool the tasks of this group run on
+  ThreadPool& getPool() const;
+
+private:
+  friend class ThreadPool;
+
+  ThreadPool& pool_;
+  std::atomic<std::size_t> pending_;
+  std::mutex exception_mutex_;
+  std::exception_ptr exception_;
+};
+
+/// @brief Call function(i) for every i in [begin, end) on the threads of pool
+/// and return once all calls finished. Indices are handed out in blocks of
+/// grain_size.
+template <typename Function>
+void parallelFor(ThreadPool& pool, std::size_t begin, std::size_t end,
+                 const Function& function, std::size_t grain_size = 1);
+
+//==============================================================================
+template <typename Function>
+void parallelFor(ThreadPool& pool, std::size_t begin, std::size_t end,
+                 const Function& function, std::size_t grain_size)
+{
+  if(begin >= end) return;
+  if(grain_size == 0) grain_size = 1;
+
+  if(pool.getNumThreads() == 1 || end - begin <= grain_size)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+      function(i);
+    return;
+  }
+
+  TaskGroup group(pool);
+  for(std::size_t block_begin = begin; block_begin < end; block_begin += grain_size)
+  {
+    const std::size_t block_end = std::min(block_begin + grain_size, end);
+    group.run([&function, block_begin, block_end]()
+    {
+      for(std::size_t i = block_begin; i < block_end; ++i)
+        function(i);
+    });
+  }
+  group.wait();
+}
+
+} // namespace fcl
+
+#endif
@@ -71,6 +71,13 @@ enum BVHReturnCode
     BVH_ERR_UNKNOWN = -8                        /// Unknown failure
   };
 
+/// @brief Algorithm building the bounding volume hierarchy of a BVH model
+enum BVHBuildMethod
+  {
+    BVH_BUILD_METHOD_TOP_DOWN,      /// @brief recursive top-down splits by the model's splitter
+    BVH_BUILD_METHOD_LBVH           /// @brief linear BVH over the Morton-sorted primitives, fitted bottom-up
+  };
+
 /// @brief BVH model type
 enum BVHModelType
   {
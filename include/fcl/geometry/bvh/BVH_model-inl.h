@@ -40,6 +40,9 @@
 
 #include "fcl/geometry/bvh/BVH_model.h"
 #include <new>
+#include <type_traits>
+#include "fcl/broadphase/detail/morton.h"
+#include "fcl/common/detail/radix_sort.h"
 
 namespace fcl
 {
@@ -64,15 +67,20 @@ BVHModel<BV>::BVHModel() : vertices(nullptr),
   num_tris(0),
   num_vertices(0),
   build_state(BVH_BUILD_STATE_EMPTY),
+  build_method(BVH_BUILD_METHOD_TOP_DOWN),
   bv_splitter(new detail::BVSplitter<BV>(detail::SPLIT_METHOD_MEAN)),
   bv_fitter(new detail::BVFitter<BV>()),
+  build_pool(nullptr),
+  parallel_build_threshold(4096),
   num_tris_allocated(0),
   num_vertices_allocated(0),
   num_bvs_allocated(0),
   num_vertex_updated(0),
   primitive_indices(nullptr),
   bvs(nullptr),
-  num_bvs(0)
+  num_bvs(0),
+  wide_bvh4(nullptr),
+  wide_bvh8(nullptr)
 {
   // Do nothing
 }
@@ -84,8 +92,11 @@ BVHModel<BV>::BVHModel(const BVHModel<BV>& other)
     num_tris(other.num_tris),
     num_vertices(other.num_vertices),
     build_state(other.build_state),
+    build_method(other.build_method),
     bv_splitter(other.bv_splitter),
     bv_fitter(other.bv_fitter),
+    build_pool(other.build_pool),
+    parallel_build_threshold(other.parallel_build_threshold),
     num_tris_allocated(other.num_tris),
     num_vertices_allocated(other.num_vertices)
 {
@@ -142,6 +153,9 @@ BVHModel<BV>::BVHModel(const BVHModel<BV>& other)
   }
   else
     bvs = nullptr;
+
+  wide_bvh4 = other.wide_bvh4;
+  wide_bvh8 = other.wide_bvh8;
 }
 
 //==============================================================================
@@ -214,6 +228,8 @@ int BVHModel<BV>::beginModel(int num_tris_, int num_vertices_)
     delete [] primitive_indices; primitive_indices = nullptr;
 
     num_vertices_allocated = num_vertices = num_tris_allocated = num_tris = num_bvs_allocated = num_bvs = 0;
+    wide_bvh4.reset();
+    wide_bvh8.reset();
   }
 
   if(num_tris_ < 0) num_tris_ = 8;
@@ -756,10 +772,53 @@ int BVHModel<BV>::memUsage(int msg) const
 template <typename BV>
 void BVHModel<BV>::makeParentRelative()
 {
+  wide_bvh4.reset();
+  wide_bvh8.reset();
+
   makeParentRelativeRecurse(
         0, Matrix3<S>::Identity(), Vector3<S>::Zero());
 }
 
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::buildWideBVH(int width)
+{
+  if(build_state != BVH_BUILD_STATE_PROCESSED && build_state != BVH_BUILD_STATE_UPDATED)
+  {
+    std::cerr << "BVH Error! Call buildWideBVH() on a BVHModel that is not built." << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  switch(width)
+  {
+  case 4:
+    wide_bvh4 = std::make_shared<const WideBVH<BV, 4>>(bvs, num_bvs);
+    break;
+  case 8:
+    wide_bvh8 = std::make_shared<const WideBVH<BV, 8>>(bvs, num_bvs);
+    break;
+  default:
+    std::cerr << "BVH Error! Wide hierarchies have 4 or 8 children per node." << std::endl;
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+const WideBVH<BV, 4>* BVHModel<BV>::getWideBVH4() const
+{
+  return wide_bvh4.get();
+}
+
+//==============================================================================
+template <typename BV>
+const WideBVH<BV, 8>* BVHModel<BV>::getWideBVH8() const
+{
+  return wide_bvh8.get();
+}
+
 //==============================================================================
 template <typename BV>
 Vector3<typename BV::S> BVHModel<BV>::computeCOM() const
@@ -831,13 +890,14 @@ Matrix3<typename BV::S> BVHModel<BV>::computeMomentofInertia() const
 template <typename BV>
 int BVHModel<BV>::buildTree()
 {
+  wide_bvh4.reset();
+  wide_bvh8.reset();
+
   // set BVFitter
   bv_fitter->set(vertices, tri_indices, getModelType());
   // set SplitRule
   bv_splitter->set(vertices, tri_indices, getModelType());
 
-  num_bvs = 1;
-
   int num_primitives = 0;
   switch(getModelType())
   {
@@ -852,9 +912,62 @@ int BVHModel<BV>::buildTree()
     return BVH_ERR_UNSUPPORTED_FUNCTION;
   }
 
+  if(build_method == BVH_BUILD_METHOD_LBVH)
+  {
+    buildTree_lbvh(num_primitives);
+    num_bvs = 2 * num_primitives - 1;
+
+    bv_fitter->clear();
+    bv_splitter->clear();
+
+    return BVH_OK;
+  }
+
   for(int i = 0; i < num_primitives; ++i)
     primitive_indices[i] = i;
-  recursiveBuildTree(0, 0, num_primitives);
+
+  // One fitter and splitter per thread of the pool, if they can be cloned
+  std::vector<std::shared_ptr<detail::BVFitterBase<BV>>> fitters;
+  std::vector<std::shared_ptr<detail::BVSplitterBase<BV>>> splitters;
+  if(build_pool && build_pool->getNumThreads() > 1
+     && num_primitives >= parallel_build_threshold)
+  {
+    for(std::size_t i = 0; i < build_pool->getNumThreads(); ++i)
+    {
+      std::shared_ptr<detail::BVFitterBase<BV>> fitter = bv_fitter->clone();
+      std::shared_ptr<detail::BVSplitterBase<BV>> splitter = bv_splitter->clone();
+      if(!fitter || !splitter)
+      {
+        fitters.clear();
+        splitters.clear();
+        break;
+      }
+
+      fitter->set(vertices, tri_indices, getModelType());
+      splitter->set(vertices, tri_indices, getModelType());
+      fitters.push_back(fitter);
+      splitters.push_back(splitter);
+    }
+  }
+
+  if(!fitters.empty())
+  {
+    TaskGroup group(*build_pool);
+    recursiveBuildTree(group, fitters, splitters, 0, 1, 0, num_primitives);
+    group.wait();
+
+    for(std::size_t i = 0; i < fitters.size(); ++i)
+    {
+      fitters[i]->clear();
+      splitters[i]->clear();
+    }
+  }
+  else
+  {
+    recursiveBuildTree(*bv_fitter, *bv_splitter, 0, 1, 0, num_primitives);
+  }
+
+  num_bvs = 2 * num_primitives - 1;
 
   bv_fitter->clear();
   bv_splitter->clear();
@@ -864,82 +977,393 @@ int BVHModel<BV>::buildTree()
 
 //==============================================================================
 template <typename BV>
-int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_primitives)
+int BVHModel<BV>::recursiveBuildTree(
+    detail::BVFitterBase<BV>& fitter,
+    detail::BVSplitterBase<BV>& splitter,
+    int bv_id,
+    int first_child,
+    int first_primitive,
+    int num_primitives)
 {
-  BVHModelType type = getModelType();
-  BVNode<BV>* bvnode = bvs + bv_id;
-  unsigned int* cur_primitive_indices = primitive_indices + first_primitive;
+  const int num_first_half = buildNode(
+        fitter, splitter, bv_id, first_child, first_primitive, num_primitives);
+  if(num_first_half <= 0)
+    return num_first_half;
 
-  // constructing BV
-  BV bv = bv_fitter->fit(cur_primitive_indices, num_primitives);
-  bv_splitter->computeRule(bv, cur_primitive_indices, num_primitives);
+  // The left subtree takes 2 * num_first_half - 2 nodes below first_child + 1
+  recursiveBuildTree(fitter, splitter, first_child, first_child + 2,
+                     first_primitive, num_first_half);
+  recursiveBuildTree(fitter, splitter, first_child + 1, first_child + 2 * num_first_half,
+                     first_primitive + num_first_half, num_primitives - num_first_half);
 
-  bvnode->bv = bv;
-  bvnode->first_primitive = first_primitive;
-  bvnode->num_primitives = num_primitives;
+  return BVH_OK;
+}
 
-  if(num_primitives == 1)
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::recursiveBuildTree(
+    TaskGroup& group,
+    const std::vector<std::shared_ptr<detail::BVFitterBase<BV>>>& fitters,
+    const std::vector<std::shared_ptr<detail::BVSplitterBase<BV>>>& splitters,
+    int bv_id,
+    int first_child,
+    int first_primitive,
+    int num_primitives)
+{
+  const std::size_t thread = group.getPool().getThreadIndex();
+  detail::BVFitterBase<BV>& fitter = *fitters[thread];
+  detail::BVSplitterBase<BV>& splitter = *splitters[thread];
+
+  if(num_primitives < parallel_build_threshold)
   {
-    bvnode->first_child = -((*cur_primitive_indices) + 1);
+    recursiveBuildTree(fitter, splitter, bv_id, first_child,
+                       first_primitive, num_primitives);
+    return;
   }
-  else
+
+  const int num_first_half = buildNode(
+        fitter, splitter, bv_id, first_child, first_primitive, num_primitives);
+  if(num_first_half <= 0)
+    return;
+
+  group.run([this, &group, &fitters, &splitters, first_child, first_primitive, num_first_half]()
+  {
+    recursiveBuildTree(group, fitters, splitters, first_child, first_child + 2,
+                       first_primitive, num_first_half);
+  });
+  recursiveBuildTree(group, fitters, splitters, first_child + 1, first_child + 2 * num_first_half,
+                     first_primitive + num_first_half, num_primitives - num_first_half);
+}
+
+//==============================================================================
+template <typename BV>
+struct MergeIsTight : std::false_type {};
+
+//==============================================================================
+template <typename S>
+struct MergeIsTight<AABB<S>> : std::true_type {};
+
+//==============================================================================
+template <typename S, std::size_t N>
+struct MergeIsTight<KDOP<S, N>> : std::true_type {};
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::buildTree_lbvh(int num_primitives)
+{
+  ThreadPool* pool = nullptr;
+  if(build_pool && build_pool->getNumThreads() > 1)
+    pool = build_pool.get();
+
+  const BVHModelType type = getModelType();
+
+  // Morton codes of the primitive centroids in the box bounding them
+  std::vector<Vector3<S>> centroids(num_primitives);
+  AABB<S> bound;
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    if(type == BVH_MODEL_TRIANGLES)
+    {
+      const Triangle& t = tri_indices[i];
+      centroids[i] = (vertices[t[0]] + vertices[t[1]] + vertices[t[2]]) / 3;
+    }
+    else
+    {
+      centroids[i] = vertices[i];
+    }
+
+    bound += centroids[i];
+  }
+
+  for(int i = 0; i < 3; ++i)
   {
-    bvnode->first_child = num_bvs;
-    num_bvs += 2;
+    if(!(bound.max_[i] > bound.min_[i]))
+      bound.max_[i] = bound.min_[i] + 1;
+  }
 
-    int c1 = 0;
+  const detail::morton_functor<S, uint64> coder(bound);
+  std::vector<uint64> codes(num_primitives);
+  std::vector<unsigned int> indices(num_primitives);
+  auto encode = [&](std::size_t i)
+  {
+    codes[i] = coder(centroids[i]);
+    indices[i] = i;
+  };
+
+  if(pool)
+  {
+    parallelFor(*pool, 0, num_primitives, encode, parallel_build_threshold);
+  }
+  else
+  {
     for(int i = 0; i < num_primitives; ++i)
+      encode(i);
+  }
+
+  detail::radixSort(codes, indices, coder.bits(), pool);
+  std::copy(indices.begin(), indices.end(), primitive_indices);
+
+  if(pool)
+  {
+    TaskGroup group(*pool);
+    recursiveBuildTree_lbvh(&group, codes.data(), 0, 1, 0, num_primitives);
+    group.wait();
+  }
+  else
+  {
+    recursiveBuildTree_lbvh(nullptr, codes.data(), 0, 1, 0, num_primitives);
+  }
+
+  // One fitter per thread of the pool, if bv_fitter can be cloned
+  std::vector<std::shared_ptr<detail::BVFitterBase<BV>>> fitters;
+  if(pool)
+  {
+    for(std::size_t i = 0; i < pool->getNumThreads(); ++i)
     {
-      Vector3<S> p;
-      if(type == BVH_MODEL_POINTCLOUD) p = vertices[cur_primitive_indices[i]];
-      else if(type == BVH_MODEL_TRIANGLES)
-      {
-        const Triangle& t = tri_indices[cur_primitive_indices[i]];
-        const Vector3<S>& p1 = vertices[t[0]];
-        const Vector3<S>& p2 = vertices[t[1]];
-        const Vector3<S>& p3 = vertices[t[2]];
-        p.noalias() = (p1 + p2 + p3) / 3.0;
-      }
-      else
+      std::shared_ptr<detail::BVFitterBase<BV>> fitter = bv_fitter->clone();
+      if(!fitter)
       {
-        std::cerr << "BVH Error: Model type not supported!" << std::endl;
-        return BVH_ERR_UNSUPPORTED_FUNCTION;
+        fitters.clear();
+        pool = nullptr;
+        break;
       }
 
+      fitter->set(vertices, tri_indices, type);
+      fitters.push_back(fitter);
+    }
+  }
+
+  if(!MergeIsTight<BV>::value)
+  {
+    const int num_nodes = 2 * num_primitives - 1;
+    auto fitNode = [&](std::size_t i)
+    {
+      detail::BVFitterBase<BV>& fitter
+          = pool ? *fitters[pool->getThreadIndex()] : *bv_fitter;
+      BVNode<BV>& bvnode = bvs[i];
+      bvnode.bv = fitter.fit(primitive_indices + bvnode.first_primitive,
+                             bvnode.num_primitives);
+    };
+
+    if(pool)
+    {
+      parallelFor(*pool, 0, num_nodes, fitNode, 256);
+    }
+    else
+    {
+      for(int i = 0; i < num_nodes; ++i)
+        fitNode(i);
+    }
+  }
+  else
+  {
+    // Fit the subtrees smaller than parallel_build_threshold on the pool, then
+    // the few nodes above them, children before parents
+    std::vector<int> top_nodes;
+    std::vector<int> subtrees;
+    std::vector<int> stack(1, 0);
+    while(!stack.empty())
+    {
+      const int bv_id = stack.back();
+      stack.pop_back();
 
-      // loop invariant: up to (but not including) index c1 in group 1,
-      // then up to (but not including) index i in group 2
-      //
-      //  [1] [1] [1] [1] [2] [2] [2] [x] [x] ... [x]
-      //                   c1          i
-      //
-      if(bv_splitter->apply(p)) // in the right side
+      const BVNode<BV>& bvnode = bvs[bv_id];
+      if(pool && !bvnode.isLeaf() && bvnode.num_primitives >= parallel_build_threshold)
       {
-        // do nothing
+        top_nodes.push_back(bv_id);
+        stack.push_back(bvnode.leftChild());
+        stack.push_back(bvnode.rightChild());
       }
       else
       {
-        std::swap(cur_primitive_indices[i], cur_primitive_indices[c1]);
-        c1++;
+        subtrees.push_back(bv_id);
       }
     }
 
+    if(pool)
+    {
+      parallelFor(*pool, 0, subtrees.size(), [&](std::size_t i)
+      {
+        refitSubtree_bottomup(*fitters[pool->getThreadIndex()], subtrees[i]);
+      });
+    }
+    else
+    {
+      for(std::size_t i = 0; i < subtrees.size(); ++i)
+        refitSubtree_bottomup(*bv_fitter, subtrees[i]);
+    }
+
+    for(auto it = top_nodes.rbegin(); it != top_nodes.rend(); ++it)
+    {
+      BVNode<BV>& bvnode = bvs[*it];
+      bvnode.bv = bvs[bvnode.leftChild()].bv + bvs[bvnode.rightChild()].bv;
+    }
+  }
+
+  for(std::size_t i = 0; i < fitters.size(); ++i)
+    fitters[i]->clear();
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::recursiveBuildTree_lbvh(
+    TaskGroup* group,
+    const uint64* codes,
+    int bv_id,
+    int first_child,
+    int first_primitive,
+    int num_primitives)
+{
+  BVNode<BV>* bvnode = bvs + bv_id;
+  bvnode->first_primitive = first_primitive;
+  bvnode->num_primitives = num_primitives;
+
+  if(num_primitives == 1)
+  {
+    bvnode->first_child = -(primitive_indices[first_primitive] + 1);
+    return;
+  }
 
-    if((c1 == 0) || (c1 == num_primitives)) c1 = num_primitives / 2;
+  bvnode->first_child = first_child;
 
-    int num_first_half = c1;
+  // Split where the highest bit that differs between the first and the last
+  // code flips, in the middle if the codes are all equal
+  const uint64* first = codes + first_primitive;
+  const uint64* last = first + num_primitives - 1;
+  int num_first_half = num_primitives / 2;
+  uint64 diff = *first ^ *last;
+  if(diff != 0)
+  {
+    uint64 bit = 1;
+    while(diff >>= 1)
+      bit <<= 1;
 
-    recursiveBuildTree(bvnode->leftChild(), first_primitive, num_first_half);
-    recursiveBuildTree(bvnode->rightChild(), first_primitive + num_first_half, num_primitives - num_first_half);
+    num_first_half = std::lower_bound(first, last + 1, *last & ~(bit - 1)) - first;
   }
 
-  return BVH_OK;
+  if(group && num_primitives >= parallel_build_threshold)
+  {
+    group->run([this, group, codes, first_child, first_primitive, num_first_half]()
+    {
+      recursiveBuildTree_lbvh(group, codes, first_child, first_child + 2,
+                              first_primitive, num_first_half);
+    });
+  }
+  else
+  {
+    recursiveBuildTree_lbvh(group, codes, first_child, first_child + 2,
+                            first_primitive, num_first_half);
+  }
+
+  recursiveBuildTree_lbvh(group, codes, first_child + 1, first_child + 2 * num_first_half,
+                          first_primitive + num_first_half, num_primitives - num_first_half);
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::refitSubtree_bottomup(detail::BVFitterBase<BV>& fitter, int bv_id)
+{
+  auto refitNode = [&](int i)
+  {
+    BVNode<BV>& bvnode = bvs[i];
+    if(bvnode.isLeaf())
+      bvnode.bv = fitter.fit(primitive_indices + bvnode.first_primitive, 1);
+    else
+      bvnode.bv = bvs[bvnode.leftChild()].bv + bvs[bvnode.rightChild()].bv;
+  };
+
+  // The descendants are stored in [first_child, first_child + 2n - 2), every
+  // node before its children
+  const BVNode<BV>& root = bvs[bv_id];
+  if(!root.isLeaf())
+  {
+    for(int i = root.first_child + 2 * root.num_primitives - 3; i >= root.first_child; --i)
+      refitNode(i);
+  }
+
+  refitNode(bv_id);
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::buildNode(
+    detail::BVFitterBase<BV>& fitter,
+    detail::BVSplitterBase<BV>& splitter,
+    int bv_id,
+    int first_child,
+    int first_primitive,
+    int num_primitives)
+{
+  BVHModelType type = getModelType();
+  BVNode<BV>* bvnode = bvs + bv_id;
+  unsigned int* cur_primitive_indices = primitive_indices + first_primitive;
+
+  // constructing BV
+  BV bv = fitter.fit(cur_primitive_indices, num_primitives);
+  splitter.computeRule(bv, cur_primitive_indices, num_primitives);
+
+  bvnode->bv = bv;
+  bvnode->first_primitive = first_primitive;
+  bvnode->num_primitives = num_primitives;
+
+  if(num_primitives == 1)
+  {
+    bvnode->first_child = -((*cur_primitive_indices) + 1);
+    return 0;
+  }
+
+  bvnode->first_child = first_child;
+
+  int c1 = 0;
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    Vector3<S> p;
+    if(type == BVH_MODEL_POINTCLOUD) p = vertices[cur_primitive_indices[i]];
+    else if(type == BVH_MODEL_TRIANGLES)
+    {
+      const Triangle& t = tri_indices[cur_primitive_indices[i]];
+      const Vector3<S>& p1 = vertices[t[0]];
+      const Vector3<S>& p2 = vertices[t[1]];
+      const Vector3<S>& p3 = vertices[t[2]];
+      p.noalias() = (p1 + p2 + p3) / 3.0;
+    }
+    else
+    {
+      std::cerr << "BVH Error: Model type not supported!" << std::endl;
+      return BVH_ERR_UNSUPPORTED_FUNCTION;
+    }
+
+
+    // loop invariant: up to (but not including) index c1 in group 1,
+    // then up to (but not including) index i in group 2
+    //
+    //  [1] [1] [1] [1] [2] [2] [2] [x] [x] ... [x]
+    //                   c1          i
+    //
+    if(splitter.apply(p)) // in the right side
+    {
+      // do nothing
+    }
+    else
+    {
+      std::swap(cur_primitive_indices[i], cur_primitive_indices[c1]);
+      c1++;
+    }
+  }
+
+
+  if((c1 == 0) || (c1 == num_primitives)) c1 = num_primitives / 2;
+
+  return c1;
 }
 
 //==============================================================================
 template <typename BV>
 int BVHModel<BV>::refitTree(bool bottomup)
 {
+  wide_bvh4.reset();
+  wide_bvh8.reset();
+
   if(bottomup)
     return refitTree_bottomup();
   else
@@ -41,11 +41,13 @@
 #include <vector>
 #include <memory>
 
+#include "fcl/common/thread_pool.h"
 #include "fcl/math/bv/OBB.h"
 #include "fcl/math/bv/kDOP.h"
 #include "fcl/geometry/collision_geometry.h"
 #include "fcl/geometry/bvh/BVH_internal.h"
 #include "fcl/geometry/bvh/BV_node.h"
+#include "fcl/geometry/bvh/BVH_wide.h"
 #include "fcl/geometry/bvh/detail/BV_splitter.h"
 #include "fcl/geometry/bvh/detail/BV_fitter.h"
 
@@ -151,6 +153,22 @@ public:
   /// BV node. When traversing the BVH, this can save one matrix transformation.
   void makeParentRelative();
 
+  /// @brief Collapse the bounding volume hierarchy into a wide one with up to
+  /// width (4 or 8) children per node. Queries between two OBB, RSS or OBBRSS
+  /// models that both have a wide hierarchy of the same width traverse the
+  /// wide hierarchies instead of the binary ones. The wide hierarchy is
+  /// dropped whenever the binary one is rebuilt or refitted; it must be
+  /// rebuilt by hand after modifying bounding volumes through getBV().
+  int buildWideBVH(int width = 4);
+
+  /// @brief The wide hierarchy with 4 children per node, or nullptr if it was
+  /// not built
+  const WideBVH<BV, 4>* getWideBVH4() const;
+
+  /// @brief The wide hierarchy with 8 children per node, or nullptr if it was
+  /// not built
+  const WideBVH<BV, 8>* getWideBVH8() const;
+
   Vector3<S> computeCOM() const override;
 
   S computeVolume() const override;
@@ -176,12 +194,37 @@ public:
   /// @brief The state of BVH building process
   BVHBuildState build_state;
 
+  /// @brief The algorithm buildTree() uses. BVH_BUILD_METHOD_LBVH sorts the
+  /// primitives by the Morton code of their centroids and splits every node
+  /// where the highest differing bit of the codes flips; bv_splitter is
+  /// ignored. For AABB and KDOP, inner nodes are the union of their children
+  /// and the whole build is linear in the number of primitives. Merging
+  /// oriented bounding volumes is far from tight, so for the other types
+  /// every node is fitted to its primitives with bv_fitter, which is
+  /// O(n log n). It is meant for deforming meshes that are rebuilt every
+  /// frame: queries on the result are usually slower than on a top-down
+  /// hierarchy.
+  BVHBuildMethod build_method;
+
   /// @brief Split rule to split one BV node into two children
   std::shared_ptr<detail::BVSplitterBase<BV>> bv_splitter;
 
   /// @brief Fitting rule to fit a BV node to a set of geometry primitives
   std::shared_ptr<detail::BVFitterBase<BV>> bv_fitter;
 
+  /// @brief Optional thread pool the hierarchy is built on. Subtrees with at
+  /// least parallel_build_threshold primitives are built as separate tasks,
+  /// each thread splitting with its own clone of bv_splitter and bv_fitter.
+  /// The hierarchy is the same as the one built serially. The build stays
+  /// serial if the pool is null or has one thread, or if bv_splitter or
+  /// bv_fitter cannot be cloned. With BVH_BUILD_METHOD_LBVH the Morton codes
+  /// are also computed and radix sorted on the pool.
+  std::shared_ptr<ThreadPool> build_pool;
+
+  /// @brief The number of primitives from which a subtree is built as a task
+  /// of build_pool
+  int parallel_build_threshold;
+
 private:
 
   int num_tris_allocated;
@@ -196,6 +239,11 @@ private:
   /// @brief Number of BV nodes in bounding volume hierarchy
   int num_bvs;
 
+  /// @brief Optional wide bounding volume hierarchies, shared by the copies of
+  /// the model
+  std::shared_ptr<const WideBVH<BV, 4>> wide_bvh4;
+  std::shared_ptr<const WideBVH<BV, 8>> wide_bvh8;
+
   /// @brief Build the bounding volume hierarchy
   int buildTree();
 
@@ -208,8 +256,62 @@ private:
   /// @brief Refit the bounding volume hierarchy in a bottom-up way (fast but less compact)
   int refitTree_bottomup();
 
-  /// @brief Recursive kernel for hierarchy construction
-  int recursiveBuildTree(int bv_id, int first_primitive, int num_primitives);
+  /// @brief Recursive kernel for hierarchy construction. The children of
+  /// bv_id are stored at first_child and first_child + 1; since a subtree over
+  /// n primitives has 2n - 1 nodes, the indices of all nodes below follow from
+  /// the sizes of the partitions.
+  int recursiveBuildTree(
+      detail::BVFitterBase<BV>& fitter,
+      detail::BVSplitterBase<BV>& splitter,
+      int bv_id,
+      int first_child,
+      int first_primitive,
+      int num_primitives);
+
+  /// @brief Recursive kernel for hierarchy construction on a thread pool, the
+  /// left child of every node with at least parallel_build_threshold
+  /// primitives being built as a new task of group. fitters and splitters
+  /// hold one clone per thread of the pool.
+  void recursiveBuildTree(
+      TaskGroup& group,
+      const std::vector<std::shared_ptr<detail::BVFitterBase<BV>>>& fitters,
+      const std::vector<std::shared_ptr<detail::BVSplitterBase<BV>>>& splitters,
+      int bv_id,
+      int first_child,
+      int first_primitive,
+      int num_primitives);
+
+  /// @brief Build the hierarchy with BVH_BUILD_METHOD_LBVH
+  void buildTree_lbvh(int num_primitives);
+
+  /// @brief Recursive kernel emitting the nodes of a linear BVH, given the
+  /// sorted Morton codes of the primitives. Nodes with at least
+  /// parallel_build_threshold primitives build their left child as a new task
+  /// of group, if group is not null. Bounding volumes are not computed.
+  void recursiveBuildTree_lbvh(
+      TaskGroup* group,
+      const uint64* codes,
+      int bv_id,
+      int first_child,
+      int first_primitive,
+      int num_primitives);
+
+  /// @brief Fit the leaves of the subtree of bv_id with fitter and the inner
+  /// nodes as the union of their children. Relies on the descendants of a
+  /// node being stored right after its children, as buildTree() lays them
+  /// out.
+  void refitSubtree_bottomup(detail::BVFitterBase<BV>& fitter, int bv_id);
+
+  /// @brief Fit the bounding volume of node bv_id and partition its
+  /// primitives. Returns the number of primitives of the left child, 0 for a
+  /// leaf.
+  int buildNode(
+      detail::BVFitterBase<BV>& fitter,
+      detail::BVSplitterBase<BV>& splitter,
+      int bv_id,
+      int first_child,
+      int first_primitive,
+      int num_primitives);
 
   /// @brief Recursive kernel for bottomup refitting 
   int recursiveRefitTree_bottomup(int bv_id);
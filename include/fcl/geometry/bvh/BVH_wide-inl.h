@@ -0,0 +1,192 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_WIDE_INL_H
+#define FCL_BVH_WIDE_INL_H
+
+#include "fcl/geometry/bvh/BVH_wide.h"
+
+#include <algorithm>
+#include "fcl/math/bv/utility.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+struct FCL_EXPORT WideBVNode<double, 4>;
+
+//==============================================================================
+extern template
+struct FCL_EXPORT WideBVNode<double, 8>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<OBB<double>, 4>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<OBB<double>, 8>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<RSS<double>, 4>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<RSS<double>, 8>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<OBBRSS<double>, 4>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT WideBVH<OBBRSS<double>, 8>;
+
+//==============================================================================
+template <typename S, int N>
+bool WideBVNode<S, N>::isChildLeaf(int i) const
+{
+  return child[i] < 0;
+}
+
+//==============================================================================
+template <typename BV, int N>
+WideBVH<BV, N>::WideBVH(const BVNode<BV>* bvs, int num_bvs) : depth(0)
+{
+  static_assert(N >= 2, "A wide node needs at least two children");
+
+  if(num_bvs == 0 || bvs[0].isLeaf())
+    return;
+
+  // A binary hierarchy with n leaves has n - 1 inner nodes, and every wide
+  // node stands for one of them
+  nodes.reserve(num_bvs / 2);
+  recursiveBuild(bvs, 0, 1);
+}
+
+//==============================================================================
+template <typename BV, int N>
+const WideBVNode<typename BV::S, N>& WideBVH<BV, N>::getNode(int id) const
+{
+  return nodes[id];
+}
+
+//==============================================================================
+template <typename BV, int N>
+int WideBVH<BV, N>::getNumNodes() const
+{
+  return static_cast<int>(nodes.size());
+}
+
+//==============================================================================
+template <typename BV, int N>
+int WideBVH<BV, N>::getDepth() const
+{
+  return depth;
+}
+
+//==============================================================================
+template <typename BV, int N>
+int WideBVH<BV, N>::recursiveBuild(const BVNode<BV>* bvs, int bv_id, int level)
+{
+  depth = std::max(depth, level);
+
+  const int id = static_cast<int>(nodes.size());
+  nodes.push_back(WideBVNode<S, N>());
+
+  // Replace the largest inner candidate by its children until there are N
+  // candidates or all of them are leaves, keeping the order of the binary
+  // hierarchy
+  int candidates[N];
+  int num_candidates = 2;
+  candidates[0] = bvs[bv_id].leftChild();
+  candidates[1] = bvs[bv_id].rightChild();
+
+  while(num_candidates < N)
+  {
+    int largest = -1;
+    S largest_size = 0;
+    for(int i = 0; i < num_candidates; ++i)
+    {
+      const BVNode<BV>& bvnode = bvs[candidates[i]];
+      if(bvnode.isLeaf())
+        continue;
+
+      const S size = bvnode.bv.size();
+      if(largest < 0 || size > largest_size)
+      {
+        largest = i;
+        largest_size = size;
+      }
+    }
+
+    if(largest < 0)
+      break;
+
+    const BVNode<BV>& expanded = bvs[candidates[largest]];
+    for(int i = num_candidates; i > largest + 1; --i)
+      candidates[i] = candidates[i - 1];
+    candidates[largest] = expanded.leftChild();
+    candidates[largest + 1] = expanded.rightChild();
+    ++num_candidates;
+  }
+
+  OBB<S> box;
+  for(int i = 0; i < num_candidates; ++i)
+  {
+    computeBoundingOBB(bvs[candidates[i]].bv, box);
+    nodes[id].bounds.push_back(box);
+    nodes[id].bv_index[i] = candidates[i];
+    nodes[id].child[i] = -1;
+  }
+  nodes[id].num_children = num_candidates;
+
+  // The nodes may be reallocated by the recursion, hence the indexing
+  for(int i = 0; i < num_candidates; ++i)
+  {
+    if(!bvs[candidates[i]].isLeaf())
+    {
+      const int child_id = recursiveBuild(bvs, candidates[i], level + 1);
+      nodes[id].child[i] = child_id;
+    }
+  }
+
+  return id;
+}
+
+} // namespace fcl
+
+#endif
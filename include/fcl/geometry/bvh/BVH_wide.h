@@ -0,0 +1,114 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_WIDE_H
+#define FCL_BVH_WIDE_H
+
+#include <vector>
+#include "fcl/math/bv/OBB_packet.h"
+#include "fcl/geometry/bvh/BV_node.h"
+
+namespace fcl
+{
+
+/// @brief Node of a wide bounding volume hierarchy. Its children are nodes of
+/// the binary hierarchy it was collapsed from, and the oriented boxes that
+/// enclose them are stored component-wise so that a single packet test
+/// covers all the children.
+template <typename S, int N>
+struct FCL_EXPORT WideBVNode
+{
+  /// @brief Oriented boxes enclosing the children, see computeBoundingOBB()
+  OBBPacket<S, N> bounds;
+
+  /// @brief Index of each child in the binary hierarchy
+  int bv_index[N];
+
+  /// @brief Index of the wide node of each child, or -1 if the child is a leaf
+  /// of the binary hierarchy
+  int child[N];
+
+  /// @brief Number of children, between 2 and N
+  int num_children;
+
+  /// @brief Whether the i-th child is a leaf of the binary hierarchy
+  bool isChildLeaf(int i) const;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief Bounding volume hierarchy with up to N children per node, obtained
+/// by collapsing the binary hierarchy of a BVHModel. Every wide node stands
+/// for an inner node of the binary hierarchy and adopts the nodes below it,
+/// largest first, until it has N children, which roughly divides the depth of
+/// the hierarchy by log2(N). The wide hierarchy refers to the binary one by
+/// index and does not own any bounding volume; it must be rebuilt whenever
+/// the binary hierarchy changes.
+template <typename BV, int N>
+class FCL_EXPORT WideBVH
+{
+public:
+
+  using S = typename BV::S;
+
+  /// @brief Collapse the binary hierarchy given by its nodes. The root of the
+  /// hierarchy is bvs[0]. No wide node is created if the root is a leaf.
+  WideBVH(const BVNode<BV>* bvs, int num_bvs);
+
+  /// @brief Access a wide node. The root is the node 0.
+  const WideBVNode<S, N>& getNode(int id) const;
+
+  /// @brief Number of wide nodes
+  int getNumNodes() const;
+
+  /// @brief Number of wide nodes on the longest path from the root to a leaf
+  int getDepth() const;
+
+private:
+
+  std::vector<WideBVNode<S, N>, Eigen::aligned_allocator<WideBVNode<S, N>>> nodes;
+
+  int depth;
+
+  /// @brief Create the wide node standing for the inner node bv_id of the
+  /// binary hierarchy and, recursively, the wide nodes below it. Returns the
+  /// index of the new wide node.
+  int recursiveBuild(const BVNode<BV>* bvs, int bv_id, int level);
+};
+
+} // namespace fcl
+
+#include "fcl/geometry/bvh/BVH_wide-inl.h"
+
+#endif
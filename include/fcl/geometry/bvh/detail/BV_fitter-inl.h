@@ -101,6 +101,13 @@ void BVFitter<BV>::clear()
   type = BVH_MODEL_UNKNOWN;
 }
 
+//==============================================================================
+template <typename BV>
+std::shared_ptr<BVFitterBase<BV>> BVFitter<BV>::clone() const
+{
+  return std::make_shared<BVFitter<BV>>();
+}
+
 //==============================================================================
 template <typename S, typename BV>
 struct SetImpl
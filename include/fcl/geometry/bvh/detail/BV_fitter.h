@@ -80,6 +80,9 @@ public:
   /// @brief Clear the geometry primitive data
   void clear();
 
+  /// @brief Create a default fitter with no primitive data set
+  std::shared_ptr<BVFitterBase<BV>> clone() const override;
+
 private:
 
   Vector3<S>* vertices;
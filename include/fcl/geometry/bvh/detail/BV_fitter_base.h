@@ -43,6 +43,7 @@
 #include "fcl/math/bv/kIOS.h"
 #include "fcl/math/bv/OBBRSS.h"
 #include <iostream>
+#include <memory>
 
 namespace fcl
 {
@@ -69,6 +70,14 @@ public:
 
   /// @brief clear the temporary data generated.
   virtual void clear() = 0;
+
+  /// @brief Create a fitter of the same kind with no primitives set, so that
+  /// several threads can fit bounding volumes at the same time. The default
+  /// returns nullptr, which makes BVHModel build its hierarchy serially.
+  virtual std::shared_ptr<BVFitterBase<BV>> clone() const
+  {
+    return nullptr;
+  }
 };
 
 } // namespace detail
@@ -40,6 +40,8 @@
 
 #include "fcl/geometry/bvh/detail/BV_splitter.h"
 
+#include <algorithm>
+#include <limits>
 #include "fcl/common/unused.h"
 
 namespace fcl
@@ -89,6 +91,9 @@ void BVSplitter<BV>::computeRule(
   case SPLIT_METHOD_BV_CENTER:
     computeRule_bvcenter(bv, primitive_indices, num_primitives);
     break;
+  case SPLIT_METHOD_SAH:
+    computeRule_sah(bv, primitive_indices, num_primitives);
+    break;
   default:
     std::cerr << "Split method not supported" << std::endl;
   }
@@ -255,6 +260,37 @@ void BVSplitter<BV>::computeRule_median(
         *this, bv, primitive_indices, num_primitives);
 }
 
+//==============================================================================
+template <typename S, typename BV>
+struct ComputeRuleSAHImpl
+{
+  static void run(
+      BVSplitter<BV>& splitter,
+      const BV& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    if(!computeSplit_sah<S>(
+         Matrix3<S>::Identity(), splitter.vertices, splitter.tri_indices,
+         primitive_indices, num_primitives, splitter.type,
+         splitter.sah_bounds, splitter.sah_centroids,
+         splitter.split_axis, splitter.split_value))
+    {
+      ComputeRuleMeanImpl<S, BV>::run(
+            splitter, bv, primitive_indices, num_primitives);
+    }
+  }
+};
+
+//==============================================================================
+template <typename BV>
+void BVSplitter<BV>::computeRule_sah(
+    const BV& bv, unsigned int* primitive_indices, int num_primitives)
+{
+  ComputeRuleSAHImpl<S, BV>::run(
+        *this, bv, primitive_indices, num_primitives);
+}
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, OBB<S>>
@@ -304,6 +340,32 @@ struct ComputeRuleMedianImpl<S, OBB<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, OBB<S>>
+{
+  static void run(
+      BVSplitter<OBB<S>>& splitter,
+      const OBB<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    int axis;
+    if(computeSplit_sah<S>(
+         bv.axis, splitter.vertices, splitter.tri_indices, primitive_indices,
+         num_primitives, splitter.type, splitter.sah_bounds,
+         splitter.sah_centroids, axis, splitter.split_value))
+    {
+      splitter.split_vector = bv.axis.col(axis);
+    }
+    else
+    {
+      ComputeRuleMeanImpl<S, OBB<S>>::run(
+            splitter, bv, primitive_indices, num_primitives);
+    }
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, RSS<S>>
@@ -353,6 +415,32 @@ struct ComputeRuleMedianImpl<S, RSS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, RSS<S>>
+{
+  static void run(
+      BVSplitter<RSS<S>>& splitter,
+      const RSS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    int axis;
+    if(computeSplit_sah<S>(
+         bv.axis, splitter.vertices, splitter.tri_indices, primitive_indices,
+         num_primitives, splitter.type, splitter.sah_bounds,
+         splitter.sah_centroids, axis, splitter.split_value))
+    {
+      splitter.split_vector = bv.axis.col(axis);
+    }
+    else
+    {
+      ComputeRuleMeanImpl<S, RSS<S>>::run(
+            splitter, bv, primitive_indices, num_primitives);
+    }
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, kIOS<S>>
@@ -402,6 +490,32 @@ struct ComputeRuleMedianImpl<S, kIOS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, kIOS<S>>
+{
+  static void run(
+      BVSplitter<kIOS<S>>& splitter,
+      const kIOS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    int axis;
+    if(computeSplit_sah<S>(
+         bv.obb.axis, splitter.vertices, splitter.tri_indices, primitive_indices,
+         num_primitives, splitter.type, splitter.sah_bounds,
+         splitter.sah_centroids, axis, splitter.split_value))
+    {
+      splitter.split_vector = bv.obb.axis.col(axis);
+    }
+    else
+    {
+      ComputeRuleMeanImpl<S, kIOS<S>>::run(
+            splitter, bv, primitive_indices, num_primitives);
+    }
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ComputeRuleCenterImpl<S, OBBRSS<S>>
@@ -451,6 +565,32 @@ struct ComputeRuleMedianImpl<S, OBBRSS<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct ComputeRuleSAHImpl<S, OBBRSS<S>>
+{
+  static void run(
+      BVSplitter<OBBRSS<S>>& splitter,
+      const OBBRSS<S>& bv,
+      unsigned int* primitive_indices,
+      int num_primitives)
+  {
+    int axis;
+    if(computeSplit_sah<S>(
+         bv.obb.axis, splitter.vertices, splitter.tri_indices, primitive_indices,
+         num_primitives, splitter.type, splitter.sah_bounds,
+         splitter.sah_centroids, axis, splitter.split_value))
+    {
+      splitter.split_vector = bv.obb.axis.col(axis);
+    }
+    else
+    {
+      ComputeRuleMeanImpl<S, OBBRSS<S>>::run(
+            splitter, bv, primitive_indices, num_primitives);
+    }
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct ApplyImpl<S, OBB<S>>
@@ -508,6 +648,13 @@ void BVSplitter<BV>::clear()
   type = BVH_MODEL_UNKNOWN;
 }
 
+//==============================================================================
+template <typename BV>
+std::shared_ptr<BVSplitterBase<BV>> BVSplitter<BV>::clone() const
+{
+  return std::make_shared<BVSplitter<BV>>(split_method);
+}
+
 //==============================================================================
 template <typename S, typename BV>
 struct ComputeSplitVectorImpl
@@ -679,6 +826,121 @@ void computeSplitValue_median(
   }
 }
 
+//==============================================================================
+template <typename S>
+bool computeSplit_sah(
+    const Matrix3<S>& axis,
+    Vector3<S>* vertices,
+    Triangle* triangles,
+    unsigned int* primitive_indices,
+    int num_primitives,
+    BVHModelType type,
+    std::vector<AABB<S>>& bounds,
+    std::vector<Vector3<S>>& centroids,
+    int& split_axis,
+    S& split_value)
+{
+  const int num_bins = 16;
+
+  auto surfaceArea = [](const AABB<S>& box)
+  {
+    const Vector3<S> d = box.max_ - box.min_;
+    return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+  };
+
+  // Bounds and centroids of the primitives in the frame of axis
+  bounds.resize(num_primitives);
+  centroids.resize(num_primitives);
+  AABB<S> centroid_bounds;
+
+  for(int i = 0; i < num_primitives; ++i)
+  {
+    if(type == BVH_MODEL_TRIANGLES)
+    {
+      const Triangle& t = triangles[primitive_indices[i]];
+      const Vector3<S> p1 = axis.transpose() * vertices[t[0]];
+      const Vector3<S> p2 = axis.transpose() * vertices[t[1]];
+      const Vector3<S> p3 = axis.transpose() * vertices[t[2]];
+
+      bounds[i] = AABB<S>(p1, p2, p3);
+      centroids[i] = (p1 + p2 + p3) / 3;
+    }
+    else if(type == BVH_MODEL_POINTCLOUD)
+    {
+      const Vector3<S> p = axis.transpose() * vertices[primitive_indices[i]];
+
+      bounds[i] = AABB<S>(p);
+      centroids[i] = p;
+    }
+
+    centroid_bounds += centroids[i];
+  }
+
+  S best_cost = std::numeric_limits<S>::max();
+  split_axis = -1;
+
+  for(int d = 0; d < 3; ++d)
+  {
+    const S lower = centroid_bounds.min_[d];
+    const S extent = centroid_bounds.max_[d] - lower;
+    if(!(extent > 0))
+      continue;
+
+    int bin_counts[num_bins] = {0};
+    AABB<S> bin_bounds[num_bins];
+    const S scale = num_bins / extent;
+
+    for(int i = 0; i < num_primitives; ++i)
+    {
+      const int bin = std::min(
+            num_bins - 1, static_cast<int>((centroids[i][d] - lower) * scale));
+      bin_counts[bin]++;
+      bin_bounds[bin] += bounds[i];
+    }
+
+    // Cost of the right side of every plane, then sweep the left side
+    S right_areas[num_bins];
+    int right_counts[num_bins];
+    AABB<S> right_bounds;
+    int right_count = 0;
+    for(int bin = num_bins - 1; bin > 0; --bin)
+    {
+      if(bin_counts[bin] > 0)
+      {
+        right_bounds += bin_bounds[bin];
+        right_count += bin_counts[bin];
+      }
+      right_counts[bin] = right_count;
+      right_areas[bin] = (right_count > 0) ? surfaceArea(right_bounds) : 0;
+    }
+
+    AABB<S> left_bounds;
+    int left_count = 0;
+    for(int bin = 0; bin < num_bins - 1; ++bin)
+    {
+      if(bin_counts[bin] > 0)
+      {
+        left_bounds += bin_bounds[bin];
+        left_count += bin_counts[bin];
+      }
+
+      if(left_count == 0 || right_counts[bin + 1] == 0)
+        continue;
+
+      const S cost = left_count * surfaceArea(left_bounds)
+          + right_counts[bin + 1] * right_areas[bin + 1];
+      if(cost < best_cost)
+      {
+        best_cost = cost;
+        split_axis = d;
+        split_value = lower + (bin + 1) / scale;
+      }
+    }
+  }
+
+  return split_axis >= 0;
+}
+
 } // namespace detail
 } // namespace fcl
 
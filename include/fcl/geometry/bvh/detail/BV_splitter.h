@@ -41,6 +41,7 @@
 #include <vector>
 #include <iostream>
 #include "fcl/math/triangle.h"
+#include "fcl/math/bv/AABB.h"
 #include "fcl/math/bv/kIOS.h"
 #include "fcl/math/bv/OBBRSS.h"
 #include "fcl/geometry/bvh/BVH_internal.h"
@@ -52,12 +53,15 @@ namespace fcl
 namespace detail
 {
 
-/// @brief Three types of split algorithms are provided in FCL as default
+/// @brief Four types of split algorithms are provided in FCL as default
 enum SplitMethodType
 {
   SPLIT_METHOD_MEAN,
   SPLIT_METHOD_MEDIAN,
-  SPLIT_METHOD_BV_CENTER
+  SPLIT_METHOD_BV_CENTER,
+  /// Binned surface area heuristic: slower to build, but the resulting
+  /// hierarchy is usually cheaper to traverse
+  SPLIT_METHOD_SAH
 };
 
 /// @brief A class describing the split rule that splits each BV node
@@ -88,6 +92,10 @@ public:
   /// @brief Clear the geometry data set before
   void clear();
 
+  /// @brief Create a splitter with the same split method and no geometry
+  /// data set
+  std::shared_ptr<BVSplitterBase<BV>> clone() const override;
+
 private:
 
   /// @brief The axis based on which the split decision is made. For most BV,
@@ -114,6 +122,11 @@ private:
   /// @brief The split algorithm used
   SplitMethodType split_method;
 
+  /// @brief Scratch buffers of the SAH rule, kept so that building a tree
+  /// does not allocate at every node
+  std::vector<AABB<S>> sah_bounds;
+  std::vector<Vector3<S>> sah_centroids;
+
   /// @brief Split algorithm 1: Split the node from center
   void computeRule_bvcenter(
       const BV& bv, unsigned int* primitive_indices, int num_primitives);
@@ -128,6 +141,12 @@ private:
   void computeRule_median(
       const BV& bv, unsigned int* primitive_indices, int num_primitives);
 
+  /// @brief Split algorithm 4: Split the node at the plane minimizing the
+  /// surface area heuristic, among planes at regular intervals orthogonal to
+  /// the axes of the BV (or of the world frame for axis-aligned BVs)
+  void computeRule_sah(
+      const BV& bv, unsigned int* primitive_indices, int num_primitives);
+
   template <typename, typename>
   friend struct ApplyImpl;
 
@@ -139,6 +158,9 @@ private:
 
   template <typename, typename>
   friend struct ComputeRuleMedianImpl;
+
+  template <typename, typename>
+  friend struct ComputeRuleSAHImpl;
 };
 
 template <typename S, typename BV>
@@ -169,6 +191,25 @@ void computeSplitValue_median(
     const Vector3<S>& split_vector,
     S& split_value);
 
+/// @brief Find the split plane with the lowest surface area heuristic cost
+/// among the planes orthogonal to the columns of axis that cut the range of
+/// the primitive centroids into equal bins. split_axis is the column the
+/// plane is orthogonal to and split_value its offset along that column.
+/// bounds and centroids are scratch buffers, resized to num_primitives.
+/// Returns false if the centroids cannot be separated along any column.
+template <typename S>
+bool computeSplit_sah(
+    const Matrix3<S>& axis,
+    Vector3<S>* vertices,
+    Triangle* triangles,
+    unsigned int* primitive_indices,
+    int num_primitives,
+    BVHModelType type,
+    std::vector<AABB<S>>& bounds,
+    std::vector<Vector3<S>>& centroids,
+    int& split_axis,
+    S& split_value);
+
 } // namespace detail
 } // namespace fcl
 
@@ -44,6 +44,7 @@
 #include "fcl/math/bv/OBBRSS.h"
 #include <vector>
 #include <iostream>
+#include <memory>
 
 namespace fcl
 {
@@ -75,6 +76,15 @@ public:
 
   /// @brief Clear the geometry data set before
   virtual void clear() = 0;
+
+  /// @brief Create a splitter with the same split rule and no geometry data
+  /// set, so that several threads can split nodes at the same time. The
+  /// default returns nullptr, which makes BVHModel build its hierarchy
+  /// serially.
+  virtual std::shared_ptr<BVSplitterBase<BV>> clone() const
+  {
+    return nullptr;
+  }
 };
 
 } // namespace detail
@@ -50,14 +50,14 @@ class FCL_EXPORT Convex<double>;
 //==============================================================================
 template <typename S>
 Convex<S>::Convex(
-    Vector3<S>* plane_normals, S* plane_dis, int num_planes_,
-    Vector3<S>* points, int num_points_, int* polygons_)
+    Vector3<S>* plane_normals_, S* plane_dis_, int num_planes_,
+    Vector3<S>* points_, int num_points_, int* polygons_)
   : ShapeBase<S>()
 {
-  plane_normals = plane_normals;
-  plane_dis = plane_dis;
+  plane_normals = plane_normals_;
+  plane_dis = plane_dis_;
   num_planes = num_planes_;
-  points = points;
+  points = points_;
   num_points = num_points_;
   polygons = polygons_;
   edges = nullptr;
@@ -71,6 +71,7 @@ Convex<S>::Convex(
   center = sum * (S)(1.0 / num_points);
 
   fillEdges();
+  fillNeighbors();
 }
 
 //==============================================================================
@@ -82,9 +83,14 @@ Convex<S>::Convex(const Convex& other)
   plane_dis = other.plane_dis;
   num_planes = other.num_planes;
   points = other.points;
+  num_points = other.num_points;
   polygons = other.polygons;
+  num_edges = other.num_edges;
   edges = new Edge[other.num_edges];
   memcpy(edges, other.edges, sizeof(Edge) * num_edges);
+  neighbor_offsets = other.neighbor_offsets;
+  neighbors = other.neighbors;
+  center = other.center;
 }
 
 //==============================================================================
@@ -296,6 +302,83 @@ void Convex<S>::fillEdges()
   }
 }
 
+//==============================================================================
+template <typename S>
+void Convex<S>::fillNeighbors()
+{
+  neighbor_offsets.assign(num_points + 1, 0);
+  for(int i = 0; i < num_edges; ++i)
+  {
+    ++neighbor_offsets[edges[i].first + 1];
+    ++neighbor_offsets[edges[i].second + 1];
+  }
+
+  for(int i = 0; i < num_points; ++i)
+  {
+    if(neighbor_offsets[i + 1] == 0)
+    {
+      // A point that is on no polygon cannot be reached by hill-climbing
+      neighbor_offsets.clear();
+      neighbors.clear();
+      return;
+    }
+
+    neighbor_offsets[i + 1] += neighbor_offsets[i];
+  }
+
+  neighbors.resize(neighbor_offsets[num_points]);
+  std::vector<int> fill(neighbor_offsets.begin(), neighbor_offsets.end() - 1);
+  for(int i = 0; i < num_edges; ++i)
+  {
+    neighbors[fill[edges[i].first]++] = edges[i].second;
+    neighbors[fill[edges[i].second]++] = edges[i].first;
+  }
+}
+
+//==============================================================================
+template <typename S>
+int Convex<S>::findExtremeVertex(const Vector3<S>& dir, int hint) const
+{
+  if(neighbors.empty())
+  {
+    int best = 0;
+    S maxdot = -std::numeric_limits<S>::max();
+    for(int i = 0; i < num_points; ++i)
+    {
+      S dot = dir.dot(points[i]);
+      if(dot > maxdot)
+      {
+        best = i;
+        maxdot = dot;
+      }
+    }
+    return best;
+  }
+
+  // A vertex of a convex polytope that is not the furthest along dir always
+  // has a neighbor that is further, so the climb ends at the furthest vertex
+  int best = (hint >= 0 && hint < num_points) ? hint : 0;
+  S maxdot = dir.dot(points[best]);
+  while(true)
+  {
+    int next = best;
+    for(int i = neighbor_offsets[best]; i < neighbor_offsets[best + 1]; ++i)
+    {
+      S dot = dir.dot(points[neighbors[i]]);
+      if(dot > maxdot)
+      {
+        next = neighbors[i];
+        maxdot = dot;
+      }
+    }
+
+    if(next == best)
+      return best;
+
+    best = next;
+  }
+}
+
 //==============================================================================
 template <typename S>
 std::vector<Vector3<S>> Convex<S>::getBoundVertices(
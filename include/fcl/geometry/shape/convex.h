@@ -38,6 +38,8 @@
 #ifndef FCL_SHAPE_CONVEX_H
 #define FCL_SHAPE_CONVEX_H
 
+#include <vector>
+
 #include "fcl/geometry/shape/shape_base.h"
 
 namespace fcl
@@ -90,6 +92,13 @@ public:
 
   Edge* edges;
 
+  /// @brief Vertex adjacency graph derived from the polygons: the neighbors of
+  /// points[i] are neighbors[neighbor_offsets[i]] to
+  /// neighbors[neighbor_offsets[i + 1] - 1]. Empty if some point is not a
+  /// polygon vertex, in which case support queries scan all the points.
+  std::vector<int> neighbor_offsets;
+  std::vector<int> neighbors;
+
   /// @brief center of the convex polytope, this is used for collision: center is guaranteed in the internal of the polytope (as it is convex) 
   Vector3<S> center;
 
@@ -106,10 +115,19 @@ public:
   /// a specific configuration
   std::vector<Vector3<S>> getBoundVertices(const Transform3<S>& tf) const;
 
+  /// @brief Index of the point furthest along dir. Hill-climbs the vertex
+  /// adjacency graph starting from the point with index hint (e.g. the result
+  /// of the previous query along a nearby direction), so that a well-started
+  /// query only visits a few vertices.
+  int findExtremeVertex(const Vector3<S>& dir, int hint = 0) const;
+
 protected:
 
   /// @brief Get edge information 
   void fillEdges();
+
+  /// @brief Build the vertex adjacency graph from the edges
+  void fillNeighbors();
 };
 
 using Convexf = Convex<float>;
@@ -0,0 +1,191 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BV_OBB_PACKET_INL_H
+#define FCL_BV_OBB_PACKET_INL_H
+
+#include "fcl/math/bv/OBB_packet.h"
+
+#include <cassert>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT OBBPacket<double, 4>;
+
+//==============================================================================
+extern template
+Eigen::Array<bool, 4, 1> obbDisjoint(
+    const Matrix3<double>& R0,
+    const Vector3<double>& T0,
+    const OBB<double>& a,
+    const OBBPacket<double, 4>& b);
+
+//==============================================================================
+extern template
+class FCL_EXPORT OBBPacket<double, 8>;
+
+//==============================================================================
+extern template
+Eigen::Array<bool, 8, 1> obbDisjoint(
+    const Matrix3<double>& R0,
+    const Vector3<double>& T0,
+    const OBB<double>& a,
+    const OBBPacket<double, 8>& b);
+
+//==============================================================================
+template <typename S, int N>
+OBBPacket<S, N>::OBBPacket()
+{
+  clear();
+}
+
+//==============================================================================
+template <typename S, int N>
+void OBBPacket<S, N>::clear()
+{
+  for(int i = 0; i < 3; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+      axis[i][j].setZero();
+    To[i].setZero();
+    extent[i].setZero();
+  }
+
+  size = 0;
+}
+
+//==============================================================================
+template <typename S, int N>
+void OBBPacket<S, N>::push_back(
+    const Matrix3<S>& axis_, const Vector3<S>& center, const Vector3<S>& extent_)
+{
+  assert(size < N);
+
+  for(int i = 0; i < 3; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+      axis[i][j][size] = axis_(i, j);
+    To[i][size] = center[i];
+    extent[i][size] = extent_[i];
+  }
+
+  ++size;
+}
+
+//==============================================================================
+template <typename S, int N>
+void OBBPacket<S, N>::push_back(const OBB<S>& box)
+{
+  push_back(box.axis, box.To, box.extent);
+}
+
+//==============================================================================
+template <typename S, int N>
+Eigen::Array<bool, N, 1> obbDisjoint(
+    const Matrix3<S>& R0,
+    const Vector3<S>& T0,
+    const OBB<S>& a,
+    const OBBPacket<S, N>& b)
+{
+  using Lanes = typename OBBPacket<S, N>::Lanes;
+
+  const S reps = 1e-6;
+
+  // Configuration of the boxes of b in the frame of a, i.e.,
+  // B = a.axis^T * R0 * b.axis and T = a.axis^T * (R0 * b.To + T0 - a.To)
+  const Matrix3<S> M = a.axis.transpose() * R0;
+  const Vector3<S> t = a.axis.transpose() * (T0 - a.To);
+
+  Lanes B[3][3];
+  Lanes Bf[3][3];
+  Lanes T[3];
+  for(int i = 0; i < 3; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+    {
+      B[i][j] = M(i, 0) * b.axis[0][j] + M(i, 1) * b.axis[1][j]
+          + M(i, 2) * b.axis[2][j];
+      Bf[i][j] = B[i][j].abs() + reps;
+    }
+
+    T[i] = M(i, 0) * b.To[0] + M(i, 1) * b.To[1] + M(i, 2) * b.To[2] + t[i];
+  }
+
+  const Vector3<S>& ea = a.extent;
+  const Lanes* eb = b.extent;
+
+  Eigen::Array<bool, N, 1> disjoint = Eigen::Array<bool, N, 1>::Constant(false);
+
+  // A0, A1, A2
+  for(int i = 0; i < 3; ++i)
+  {
+    disjoint = disjoint
+        || (T[i].abs() > ea[i] + Bf[i][0] * eb[0] + Bf[i][1] * eb[1] + Bf[i][2] * eb[2]);
+  }
+
+  // B0, B1, B2
+  for(int j = 0; j < 3; ++j)
+  {
+    const Lanes s = B[0][j] * T[0] + B[1][j] * T[1] + B[2][j] * T[2];
+    disjoint = disjoint
+        || (s.abs() > eb[j] + Bf[0][j] * ea[0] + Bf[1][j] * ea[1] + Bf[2][j] * ea[2]);
+  }
+
+  // Ai x Bj
+  for(int i = 0; i < 3; ++i)
+  {
+    const int i1 = (i + 1) % 3;
+    const int i2 = (i + 2) % 3;
+
+    for(int j = 0; j < 3; ++j)
+    {
+      const int j1 = (j + 1) % 3;
+      const int j2 = (j + 2) % 3;
+
+      const Lanes s = T[i2] * B[i1][j] - T[i1] * B[i2][j];
+      disjoint = disjoint
+          || (s.abs() > ea[i1] * Bf[i2][j] + ea[i2] * Bf[i1][j]
+                        + eb[j1] * Bf[i][j2] + eb[j2] * Bf[i][j1]);
+    }
+  }
+
+  return disjoint;
+}
+
+} // namespace fcl
+
+#endif
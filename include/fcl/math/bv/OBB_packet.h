@@ -0,0 +1,104 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BV_OBB_PACKET_H
+#define FCL_BV_OBB_PACKET_H
+
+#include "fcl/math/bv/OBB.h"
+
+namespace fcl
+{
+
+/// @brief Up to N oriented bounding boxes stored component-wise (structure of
+/// arrays), so that one box can be tested against all of them at once. The
+/// lanes are Eigen arrays, which Eigen maps to SSE/AVX registers when those
+/// instruction sets are enabled at compile time and to scalar code otherwise.
+template <typename S_, int N>
+class FCL_EXPORT OBBPacket
+{
+public:
+
+  using S = S_;
+
+  using Lanes = Eigen::Array<S, N, 1>;
+
+  /// @brief axis[i][j] holds the entry (i, j) of the orientation of every box
+  Lanes axis[3][3];
+
+  /// @brief Centers of the boxes
+  Lanes To[3];
+
+  /// @brief Half dimensions of the boxes
+  Lanes extent[3];
+
+  /// @brief Number of boxes in use. The remaining lanes hold zero-sized boxes
+  /// that must be ignored.
+  int size;
+
+  /// @brief Constructor, creates an empty packet
+  OBBPacket();
+
+  /// @brief Remove all the boxes
+  void clear();
+
+  /// @brief Append a box given by its orientation, center and half
+  /// dimensions. The packet must not be full.
+  void push_back(const Matrix3<S>& axis,
+                 const Vector3<S>& center,
+                 const Vector3<S>& extent);
+
+  /// @brief Append an OBB. The packet must not be full.
+  void push_back(const OBB<S>& box);
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief Check collision between box a and every box of the packet b, where
+/// the boxes of b are given in the configuration (R0, T0) relative to the
+/// frame a is expressed in. Entry i of the result is true if a and the i-th
+/// box of b are disjoint; this is the same separating axis test as
+/// obbDisjoint(), evaluated for all the lanes at once.
+template <typename S, int N>
+FCL_EXPORT
+Eigen::Array<bool, N, 1> obbDisjoint(
+    const Matrix3<S>& R0,
+    const Vector3<S>& T0,
+    const OBB<S>& a,
+    const OBBPacket<S, N>& b);
+
+} // namespace fcl
+
+#include "fcl/math/bv/OBB_packet-inl.h"
+
+#endif
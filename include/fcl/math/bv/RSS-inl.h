@@ -368,7 +368,7 @@ RSS<S> RSS<S>::operator +(const RSS<S>& other) const
   // column first matrix, as the axis in RSS
   bv.axis.col(0) = E.col(max);
   bv.axis.col(1) = E.col(mid);
-  bv.axis.col(2).noalias() = axis.col(0).cross(axis.col(1));
+  bv.axis.col(2).noalias() = bv.axis.col(0).cross(bv.axis.col(1));
 
   // set rss origin, rectangle size and radius
   getRadiusAndOriginAndRectangleSize<S>(v, nullptr, nullptr, nullptr, 16, bv.axis, bv.To, bv.l, bv.r);
@@ -959,6 +959,86 @@ class FCL_EXPORT ConvertBVImpl<double, OBBRSS<double>, RSS<double>>;
 extern template
 class FCL_EXPORT ConvertBVImpl<double, AABB<double>, RSS<double>>;
 
+//==============================================================================
+/// @brief Compute an oriented box that encloses a bounding volume of type BV.
+/// The default goes through convertBV() in identity configuration.
+template <typename S, typename BV>
+class FCL_EXPORT BoundingOBBImpl
+{
+public:
+  static void run(const BV& bv, OBB<S>& obb)
+  {
+    convertBV(bv, Transform3<S>::Identity(), obb);
+  }
+};
+
+//==============================================================================
+template <typename S>
+class FCL_EXPORT BoundingOBBImpl<S, AABB<S>>
+{
+public:
+  static void run(const AABB<S>& bv, OBB<S>& obb)
+  {
+    obb.axis.setIdentity();
+    obb.To = bv.center();
+    obb.extent = (bv.max_ - bv.min_) * 0.5;
+  }
+};
+
+//==============================================================================
+template <typename S>
+class FCL_EXPORT BoundingOBBImpl<S, OBB<S>>
+{
+public:
+  static void run(const OBB<S>& bv, OBB<S>& obb)
+  {
+    obb = bv;
+  }
+};
+
+//==============================================================================
+template <typename S>
+class FCL_EXPORT BoundingOBBImpl<S, RSS<S>>
+{
+public:
+  static void run(const RSS<S>& bv, OBB<S>& obb)
+  {
+    // The rectangle spans [0, l[0]] x [0, l[1]] from To along the first two
+    // axes
+    obb.axis = bv.axis;
+    obb.To = bv.To + bv.axis.col(0) * (0.5 * bv.l[0])
+        + bv.axis.col(1) * (0.5 * bv.l[1]);
+    obb.extent << bv.l[0] * 0.5 + bv.r, bv.l[1] * 0.5 + bv.r, bv.r;
+  }
+};
+
+//==============================================================================
+template <typename S>
+class FCL_EXPORT BoundingOBBImpl<S, OBBRSS<S>>
+{
+public:
+  static void run(const OBBRSS<S>& bv, OBB<S>& obb)
+  {
+    obb = bv.obb;
+  }
+};
+
+//==============================================================================
+extern template
+class FCL_EXPORT BoundingOBBImpl<double, AABB<double>>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT BoundingOBBImpl<double, OBB<double>>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT BoundingOBBImpl<double, RSS<double>>;
+
+//==============================================================================
+extern template
+class FCL_EXPORT BoundingOBBImpl<double, OBBRSS<double>>;
+
 //==============================================================================
 } // namespace detail
 //==============================================================================
@@ -975,6 +1055,14 @@ void convertBV(
   detail::ConvertBVImpl<typename BV1::S, BV1, BV2>::run(bv1, tf1, bv2);
 }
 
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+void computeBoundingOBB(const BV& bv, OBB<typename BV::S>& obb)
+{
+  detail::BoundingOBBImpl<typename BV::S, BV>::run(bv, obb);
+}
+
 } // namespace fcl
 
 #endif
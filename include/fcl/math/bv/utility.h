@@ -39,6 +39,7 @@
 #define FCL_MATH_BV_UTILITY_H
 
 #include "fcl/common/types.h"
+#include "fcl/math/bv/OBB.h"
 
 /** \brief Main namespace */
 namespace fcl
@@ -56,6 +57,13 @@ FCL_EXPORT
 void convertBV(
     const BV1& bv1, const Transform3<typename BV1::S>& tf1, BV2& bv2);
 
+/// @brief Compute an oriented box that encloses a bounding volume, in the frame
+/// the bounding volume is expressed in. The box is exact for AABB, OBB, RSS and
+/// OBBRSS and may be larger than needed for the other bounding volumes.
+template <typename BV>
+FCL_EXPORT
+void computeBoundingOBB(const BV& bv, OBB<typename BV::S>& obb);
+
 } // namespace fcl
 
 #include "fcl/math/bv/utility-inl.h"
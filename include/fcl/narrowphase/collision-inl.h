@@ -67,6 +67,41 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+extern template
+FCL_EXPORT
+std::size_t collideBatch(
+    const std::vector<CollisionObjectPair<double>>& pairs,
+    const CollisionRequest<double>& request,
+    std::vector<CollisionResult<double>>& results,
+    ThreadPool* pool);
+
+namespace detail
+{
+
+/// @brief A contiguous range [begin, end) of a batch sorted by node types, all
+/// of whose pairs are handled by the same entry of the function matrix.
+struct FCL_EXPORT PairBatchChunk
+{
+  /// @brief Key node_type1 * NODE_COUNT + node_type2 shared by the range
+  std::size_t key;
+  std::size_t begin;
+  std::size_t end;
+};
+
+/// @brief Stable counting sort of the indices of pairs by the node types of
+/// their objects. On return order holds the sorted indices and chunks covers
+/// order with ranges of at most max_chunk_size pairs of one key each.
+template <typename S>
+FCL_EXPORT
+void groupPairsByNodeType(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    std::size_t max_chunk_size,
+    std::vector<std::size_t>& order,
+    std::vector<PairBatchChunk>& chunks);
+
+} // namespace detail
+
 //==============================================================================
 template<typename GJKSolver>
 detail::CollisionFunctionMatrix<GJKSolver>& getCollisionFunctionLookTable()
@@ -148,6 +183,117 @@ std::size_t collide(
   return res;
 }
 
+//==============================================================================
+template <typename S, typename NarrowPhaseSolver>
+FCL_EXPORT
+std::size_t collideBatch(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    const NarrowPhaseSolver* nsolver_,
+    const CollisionRequest<S>& request,
+    std::vector<CollisionResult<S>>& results,
+    ThreadPool* pool)
+{
+  using CollisionFunc
+      = typename detail::CollisionFunctionMatrix<NarrowPhaseSolver>::CollisionFunc;
+
+  results.resize(pairs.size());
+  for(auto& result : results)
+    result.clear();
+
+  if(pairs.empty())
+    return 0;
+
+  if(request.num_max_contacts == 0)
+  {
+    std::cerr << "Warning: should stop early as num_max_contact is " << request.num_max_contacts << " !" << std::endl;
+    return 0;
+  }
+
+  const NarrowPhaseSolver default_solver;
+  const NarrowPhaseSolver* nsolver = nsolver_ ? nsolver_ : &default_solver;
+
+  const std::size_t num_threads = pool ? pool->getNumThreads() : 1;
+  const std::size_t max_chunk_size = (num_threads == 1)
+      ? pairs.size()
+      : std::max<std::size_t>(1, pairs.size() / (4 * num_threads));
+
+  std::vector<std::size_t> order;
+  std::vector<detail::PairBatchChunk> chunks;
+  detail::groupPairsByNodeType(pairs, max_chunk_size, order, chunks);
+
+  // Resolve the collision function once per chunk. Chunks of the same key are
+  // adjacent, so each unsupported pair of node types is reported once.
+  const auto& looktable = getCollisionFunctionLookTable<NarrowPhaseSolver>();
+  std::vector<CollisionFunc> funcs(chunks.size(), nullptr);
+  std::vector<bool> swapped(chunks.size(), false);
+  for(std::size_t i = 0; i < chunks.size(); ++i)
+  {
+    const CollisionObjectPair<S>& pair = pairs[order[chunks[i].begin]];
+    const CollisionGeometry<S>* o1 = pair.first->collisionGeometry().get();
+    const CollisionGeometry<S>* o2 = pair.second->collisionGeometry().get();
+    NODE_TYPE node_type1 = o1->getNodeType();
+    NODE_TYPE node_type2 = o2->getNodeType();
+
+    if(o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_BVH)
+    {
+      funcs[i] = looktable.collision_matrix[node_type2][node_type1];
+      swapped[i] = true;
+    }
+    else
+    {
+      funcs[i] = looktable.collision_matrix[node_type1][node_type2];
+    }
+
+    if(!funcs[i] && (i == 0 || chunks[i - 1].key != chunks[i].key))
+      std::cerr << "Warning: collision function between node type " << node_type1 << " and node type " << node_type2 << " is not supported"<< std::endl;
+  }
+
+  auto run_chunk = [&](std::size_t i, const NarrowPhaseSolver* solver)
+  {
+    const CollisionFunc func = funcs[i];
+    if(!func)
+      return;
+
+    for(std::size_t j = chunks[i].begin; j < chunks[i].end; ++j)
+    {
+      const std::size_t index = order[j];
+      const CollisionObject<S>* o1 = pairs[index].first;
+      const CollisionObject<S>* o2 = pairs[index].second;
+      if(swapped[i])
+        std::swap(o1, o2);
+
+      func(o1->collisionGeometry().get(), o1->getTransform(),
+           o2->collisionGeometry().get(), o2->getTransform(),
+           solver, request, results[index]);
+    }
+  };
+
+  if(num_threads == 1)
+  {
+    for(std::size_t i = 0; i < chunks.size(); ++i)
+      run_chunk(i, nsolver);
+  }
+  else
+  {
+    // Solvers may keep mutable state (e.g., the cached guess of the
+    // independent GJK solver), so every thread works on its own copy.
+    std::vector<NarrowPhaseSolver> solvers(num_threads, *nsolver);
+    parallelFor(*pool, 0, chunks.size(), [&](std::size_t i)
+    {
+      run_chunk(i, &solvers[pool->getThreadIndex()]);
+    });
+  }
+
+  std::size_t num_collisions = 0;
+  for(const auto& result : results)
+  {
+    if(result.isCollision())
+      ++num_collisions;
+  }
+
+  return num_collisions;
+}
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
@@ -200,6 +346,80 @@ std::size_t collide(
   }
 }
 
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+std::size_t collideBatch(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    const CollisionRequest<S>& request,
+    std::vector<CollisionResult<S>>& results,
+    ThreadPool* pool)
+{
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    {
+      detail::GJKSolver_libccd<S> solver;
+      return collideBatch(pairs, &solver, request, results, pool);
+    }
+  case GST_INDEP:
+    {
+      detail::GJKSolver_indep<S> solver;
+      return collideBatch(pairs, &solver, request, results, pool);
+    }
+  default:
+    std::cerr << "Warning! Invalid GJK solver" << std::endl;
+    return -1; // error
+  }
+}
+
+namespace detail
+{
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+void groupPairsByNodeType(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    std::size_t max_chunk_size,
+    std::vector<std::size_t>& order,
+    std::vector<PairBatchChunk>& chunks)
+{
+  const std::size_t num_keys = NODE_COUNT * NODE_COUNT;
+
+  std::vector<std::size_t> keys(pairs.size());
+  std::vector<std::size_t> offsets(num_keys + 1, 0);
+  for(std::size_t i = 0; i < pairs.size(); ++i)
+  {
+    keys[i] = pairs[i].first->getNodeType() * NODE_COUNT
+        + pairs[i].second->getNodeType();
+    ++offsets[keys[i] + 1];
+  }
+
+  for(std::size_t key = 0; key < num_keys; ++key)
+    offsets[key + 1] += offsets[key];
+
+  chunks.clear();
+  for(std::size_t key = 0; key < num_keys; ++key)
+  {
+    for(std::size_t begin = offsets[key]; begin < offsets[key + 1];
+        begin += max_chunk_size)
+    {
+      PairBatchChunk chunk;
+      chunk.key = key;
+      chunk.begin = begin;
+      chunk.end = std::min(begin + max_chunk_size, offsets[key + 1]);
+      chunks.push_back(chunk);
+    }
+  }
+
+  order.resize(pairs.size());
+  for(std::size_t i = 0; i < pairs.size(); ++i)
+    order[offsets[keys[i]]++] = i;
+}
+
+} // namespace detail
+
 } // namespace fcl
 
 #endif
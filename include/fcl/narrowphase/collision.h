@@ -38,6 +38,9 @@
 #ifndef FCL_COLLISION_H
 #define FCL_COLLISION_H
 
+#include <vector>
+
+#include "fcl/common/thread_pool.h"
 #include "fcl/narrowphase/collision_object.h"
 #include "fcl/narrowphase/collision_request.h"
 #include "fcl/narrowphase/collision_result.h"
@@ -65,6 +68,22 @@ std::size_t collide(const CollisionGeometry<S>* o1, const Transform3<S>& tf1,
                     const CollisionRequest<S>& request,
                     CollisionResult<S>& result);
 
+/// @brief Batched collision interface: performs the collision between the two
+/// objects of every pair with the same request, writing the outcome of
+/// pairs[i] to results[i] (results is resized to pairs.size() and every entry
+/// is cleared first). Pairs are grouped by the node types of their objects so
+/// the collision function is looked up once per group, and a single narrow
+/// phase solver is shared by the whole batch. If pool is given, the groups are
+/// split into chunks that run on its threads with one solver per thread.
+/// Return value is the number of colliding pairs.
+template <typename S>
+FCL_EXPORT
+std::size_t collideBatch(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    const CollisionRequest<S>& request,
+    std::vector<CollisionResult<S>>& results,
+    ThreadPool* pool = nullptr);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/collision-inl.h"
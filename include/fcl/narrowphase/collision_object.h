@@ -39,6 +39,7 @@
 #define FCL_COLLISION_OBJECT_H
 
 #include <memory>
+#include <utility>
 
 #include "fcl/geometry/collision_geometry.h"
 
@@ -156,6 +157,11 @@ public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+/// @brief A pair of collision objects, e.g., a candidate pair reported by a
+/// broadphase manager
+template <typename S>
+using CollisionObjectPair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
 using CollisionObjectf = CollisionObject<float>;
 using CollisionObjectd = CollisionObject<double>;
 
@@ -39,6 +39,7 @@
 #define FCL_COLLISIONREQUEST_H
 
 #include "fcl/common/types.h"
+#include "fcl/narrowphase/gjk_cache.h"
 #include "fcl/narrowphase/gjk_solver_type.h"
 
 namespace fcl
@@ -75,6 +76,10 @@ struct FCL_EXPORT CollisionRequest
   /// @brief the gjk intial guess set by user
   Vector3<S> cached_gjk_guess;
 
+  /// @brief if not null, shape-shape queries warm start GJK from the state
+  /// their pair of geometries ended with in the previous query, and update it
+  GJKCache<S>* gjk_cache;
+
   CollisionRequest(size_t num_max_contacts_ = 1,
                    bool enable_contact_ = false,
                    size_t num_max_cost_sources_ = 1,
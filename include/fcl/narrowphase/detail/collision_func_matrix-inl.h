@@ -301,9 +301,14 @@ std::size_t ShapeShapeCollide(
     nsolver->enableCachedGuess(true);
   }
 
+  if(request.gjk_cache)
+    nsolver->setGJKWarmStart(&request.gjk_cache->get(o1, o2));
+
   initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
   collide(&node);
 
+  nsolver->setGJKWarmStart(nullptr);
+
   if(request.enable_cached_gjk_guess)
     result.cached_gjk_guess = nsolver->getCachedGuess();
 
@@ -607,6 +612,24 @@ struct BVHCollideImpl<S, OBB<S>>
   }
 };
 
+//==============================================================================
+template <typename S>
+struct BVHCollideImpl<S, RSS<S>>
+{
+  static std::size_t run(
+      const CollisionGeometry<S>* o1,
+      const Transform3<S>& tf1,
+      const CollisionGeometry<S>* o2,
+      const Transform3<S>& tf2,
+      const CollisionRequest<S>& request,
+      CollisionResult<S>& result)
+  {
+    return detail::orientedMeshCollide<
+        MeshCollisionTraversalNodeRSS<S>, RSS<S>>(
+            o1, tf1, o2, tf2, request, result);
+  }
+};
+
 //==============================================================================
 template <typename S>
 struct BVHCollideImpl<S, OBBRSS<S>>
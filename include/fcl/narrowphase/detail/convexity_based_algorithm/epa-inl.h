@@ -93,7 +93,8 @@ EPA<S>::EPA(
     unsigned int max_face_num_,
     unsigned int max_vertex_num_,
     unsigned int max_iterations_, S tolerance_)
-  : max_face_num(max_face_num_),
+  : arena_scope(Arena::threadLocal()),
+    max_face_num(max_face_num_),
     max_vertex_num(max_vertex_num_),
     max_iterations(max_iterations_),
     tolerance(tolerance_)
@@ -105,16 +106,15 @@ EPA<S>::EPA(
 template <typename S>
 EPA<S>::~EPA()
 {
-  delete [] sv_store;
-  delete [] fc_store;
+  // Do nothing
 }
 
 //==============================================================================
 template <typename S>
 void EPA<S>::initialize()
 {
-  sv_store = new SimplexV[max_vertex_num];
-  fc_store = new SimplexF[max_face_num];
+  sv_store = Arena::threadLocal().allocate<SimplexV>(max_vertex_num);
+  fc_store = Arena::threadLocal().allocate<SimplexF>(max_face_num);
   status = Failed;
   normal = Vector3<S>(0, 0, 0);
   depth = 0;
@@ -38,6 +38,7 @@
 #ifndef FCL_NARROWPHASE_DETAIL_EPA_H
 #define FCL_NARROWPHASE_DETAIL_EPA_H
 
+#include "fcl/common/detail/arena.h"
 #include "fcl/narrowphase/detail/convexity_based_algorithm/gjk.h"
 
 namespace fcl
@@ -93,6 +94,10 @@ private:
   };
 
 private:
+  /// @brief Gives the vertex and face stores back to the arena of the thread
+  /// when the EPA is destroyed
+  Arena::Scope arena_scope;
+
   unsigned int max_face_num;
   unsigned int max_vertex_num;
   unsigned int max_iterations;
@@ -106,6 +111,8 @@ public:
   typename GJK<S>::Simplex result;
   Vector3<S> normal;
   S depth;
+  /// @brief Vertex and face stores, taken from the arena of the calling thread
+  /// so that running EPA does not allocate once the arena is large enough
   SimplexV* sv_store;
   SimplexF* fc_store;
   size_t nextsv;
@@ -79,7 +79,18 @@ Vector3<S> GJK<S>::getGuessFromSimplex() const
 
 //==============================================================================
 template <typename S>
-typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const Vector3<S>& guess)
+void GJK<S>::getWarmStart(GJKWarmStart<S>& warm_start) const
+{
+  warm_start.rank = simplex ? simplex->rank : 0;
+  for(size_t i = 0; i < warm_start.rank; ++i)
+    warm_start.directions[i] = simplex->c[i]->d;
+  warm_start.axis = ray;
+}
+
+//==============================================================================
+template <typename S>
+typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const Vector3<S>& guess,
+                                         const GJKWarmStart<S>* warm_start)
 {
   size_t iterations = 0;
   S alpha = 0;
@@ -99,16 +110,54 @@ typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const V
   simplices[0].rank = 0;
   ray = guess;
 
-  appendVertex(simplices[0], (ray.squaredNorm() > 0) ? (-ray).eval() : Vector3<S>::UnitX());
-  simplices[0].p[0] = 1;
-  ray = simplices[0].c[0]->w;
-  lastw[0] = lastw[1] = lastw[2] = lastw[3] = ray; // cache previous support points, the new support point will compare with it to avoid too close support points
+  // rebuild the final simplex of the previous query from its support
+  // directions, skipping the supports that coincide under the new poses
+  bool warm_started = false;
+  if(warm_start)
+  {
+    for(size_t i = 0; i < warm_start->rank; ++i)
+    {
+      appendVertex(simplices[0], warm_start->directions[i]);
+      const Vector3<S>& w = simplices[0].c[simplices[0].rank - 1]->w;
+      for(size_t j = 0; j + 1 < simplices[0].rank; ++j)
+      {
+        if((w - simplices[0].c[j]->w).squaredNorm() < tolerance)
+        {
+          removeVertex(simplices[0]);
+          break;
+        }
+      }
+    }
 
-  do
+    if(simplices[0].rank > 1)
+    {
+      for(size_t i = 0; i < simplices[0].rank; ++i)
+        lastw[i] = simplices[0].c[i]->w;
+      for(size_t i = simplices[0].rank; i < 4; ++i)
+        lastw[i] = lastw[0];
+      clastw = simplices[0].rank - 1;
+
+      warm_started = projectOrigin();
+      if(!warm_started)
+      {
+        while(simplices[0].rank > 1)
+          removeVertex(simplices[0]);
+      }
+    }
+  }
+
+  if(!warm_started)
+  {
+    if(simplices[0].rank == 0)
+      appendVertex(simplices[0], (ray.squaredNorm() > 0) ? (-ray).eval() : Vector3<S>::UnitX());
+    simplices[0].p[0] = 1;
+    ray = simplices[0].c[0]->w;
+    lastw[0] = lastw[1] = lastw[2] = lastw[3] = ray; // cache previous support points, the new support point will compare with it to avoid too close support points
+  }
+
+  while(status == Valid)
   {
-    size_t next = 1 - current;
     Simplex& curr_simplex = simplices[current];
-    Simplex& next_simplex = simplices[next];
 
     // check A: when origin is near the existing simplex, stop
     S rl = ray.norm();
@@ -150,44 +199,14 @@ typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const V
       break;
     }
 
-    typename Project<S>::ProjectResult project_res;
-    switch(curr_simplex.rank)
-    {
-    case 2:
-      project_res = Project<S>::projectLineOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w); break;
-    case 3:
-      project_res = Project<S>::projectTriangleOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w, curr_simplex.c[2]->w); break;
-    case 4:
-      project_res = Project<S>::projectTetrahedraOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w, curr_simplex.c[2]->w, curr_simplex.c[3]->w); break;
-    }
-
-    if(project_res.sqr_distance >= 0)
-    {
-      next_simplex.rank = 0;
-      ray.setZero();
-      current = next;
-      for(size_t i = 0; i < curr_simplex.rank; ++i)
-      {
-        if(project_res.encode & (1 << i))
-        {
-          next_simplex.c[next_simplex.rank] = curr_simplex.c[i];
-          next_simplex.p[next_simplex.rank++] = project_res.parameterization[i]; // weights[i];
-          ray += curr_simplex.c[i]->w * project_res.parameterization[i]; // weights[i];
-        }
-        else
-          free_v[nfree++] = curr_simplex.c[i];
-      }
-      if(project_res.encode == 15) status = Inside; // the origin is within the 4-simplex, collision
-    }
-    else
+    if(!projectOrigin())
     {
       removeVertex(simplices[current]);
       break;
     }
 
     status = ((++iterations) < max_iterations) ? status : Failed;
-
-  } while(status == Valid);
+  }
 
   simplex = &simplices[current];
   switch(status)
@@ -199,6 +218,47 @@ typename GJK<S>::Status GJK<S>::evaluate(const MinkowskiDiff<S>& shape_, const V
   return status;
 }
 
+//==============================================================================
+template <typename S>
+bool GJK<S>::projectOrigin()
+{
+  size_t next = 1 - current;
+  Simplex& curr_simplex = simplices[current];
+  Simplex& next_simplex = simplices[next];
+
+  typename Project<S>::ProjectResult project_res;
+  switch(curr_simplex.rank)
+  {
+  case 2:
+    project_res = Project<S>::projectLineOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w); break;
+  case 3:
+    project_res = Project<S>::projectTriangleOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w, curr_simplex.c[2]->w); break;
+  case 4:
+    project_res = Project<S>::projectTetrahedraOrigin(curr_simplex.c[0]->w, curr_simplex.c[1]->w, curr_simplex.c[2]->w, curr_simplex.c[3]->w); break;
+  }
+
+  if(project_res.sqr_distance < 0)
+    return false;
+
+  next_simplex.rank = 0;
+  ray.setZero();
+  current = next;
+  for(size_t i = 0; i < curr_simplex.rank; ++i)
+  {
+    if(project_res.encode & (1 << i))
+    {
+      next_simplex.c[next_simplex.rank] = curr_simplex.c[i];
+      next_simplex.p[next_simplex.rank++] = project_res.parameterization[i]; // weights[i];
+      ray += curr_simplex.c[i]->w * project_res.parameterization[i]; // weights[i];
+    }
+    else
+      free_v[nfree++] = curr_simplex.c[i];
+  }
+  if(project_res.encode == 15) status = Inside; // the origin is within the 4-simplex, collision
+
+  return true;
+}
+
 //==============================================================================
 template <typename S>
 void GJK<S>::getSupport(const Vector3<S>& d, SimplexV& sv) const
@@ -39,6 +39,7 @@
 #define FCL_NARROWPHASE_DETAIL_GJK_H
 
 #include "fcl/common/types.h"
+#include "fcl/narrowphase/gjk_cache.h"
 #include "fcl/narrowphase/detail/convexity_based_algorithm/minkowski_diff.h"
 
 namespace fcl
@@ -82,8 +83,10 @@ struct FCL_EXPORT GJK
   
   void initialize();
 
-  /// @brief GJK algorithm, given the initial value guess
-  Status evaluate(const MinkowskiDiff<S>& shape_, const Vector3<S>& guess);
+  /// @brief GJK algorithm, given the initial value guess. If warm_start holds
+  /// a simplex, GJK starts from the supports along its directions instead
+  Status evaluate(const MinkowskiDiff<S>& shape_, const Vector3<S>& guess,
+                  const GJKWarmStart<S>* warm_start = nullptr);
 
   /// @brief apply the support function along a direction, the result is return in sv
   void getSupport(const Vector3<S>& d, SimplexV& sv) const;
@@ -106,7 +109,15 @@ struct FCL_EXPORT GJK
   /// @brief get the guess from current simplex
   Vector3<S> getGuessFromSimplex() const;
 
+  /// @brief store the current simplex and separating axis for the next query
+  void getWarmStart(GJKWarmStart<S>& warm_start) const;
+
 private:
+  /// @brief project the origin on the current simplex, move the vertices
+  /// supporting the projection to the other simplex and make it current, and
+  /// set the ray to the projection. Returns false if the simplex is degenerate
+  bool projectOrigin();
+
   SimplexV store_v[4];
   SimplexV* free_v[4];
   size_t nfree;
@@ -42,6 +42,7 @@
 
 #include "fcl/common/unused.h"
 #include "fcl/common/warning.h"
+#include "fcl/common/detail/arena.h"
 
 namespace fcl
 {
@@ -170,6 +171,9 @@ template <typename S>
 struct ccd_convex_t : public ccd_obj_t
 {
   const Convex<S>* convex;
+
+  /// @brief last support vertex, where the next support query starts
+  int support_hint;
 };
 
 struct ccd_triangle_t : public ccd_obj_t
@@ -449,6 +453,163 @@ static int doSimplex(ccd_simplex_t *simplex, ccd_vec3_t *dir)
   }
 }
 
+/** The ccdPtAdd*() and ccdPtDel*() functions of libccd, except that the
+ *  elements are taken from the arena of the calling thread instead of the heap.
+ *  Deleting an element only unlinks it; its memory is given back when the
+ *  Arena::Scope around the query ends, so the polytope must not be passed to
+ *  ccdPtDestroy(). */
+static void ptNearestUpdate(ccd_pt_t *pt, ccd_pt_el_t *el)
+{
+    if (ccdEq(pt->nearest_dist, el->dist)){
+        if (el->type < pt->nearest_type){
+            pt->nearest = el;
+            pt->nearest_dist = el->dist;
+            pt->nearest_type = el->type;
+        }
+    }else if (el->dist < pt->nearest_dist){
+        pt->nearest = el;
+        pt->nearest_dist = el->dist;
+        pt->nearest_type = el->type;
+    }
+}
+
+static ccd_pt_vertex_t *ptAddVertex(ccd_pt_t *pt, const ccd_support_t *v)
+{
+    ccd_pt_vertex_t *vert;
+
+    vert = Arena::threadLocal().allocate<ccd_pt_vertex_t>(1);
+    vert->type = CCD_PT_VERTEX;
+    ccdSupportCopy(&vert->v, v);
+
+    vert->dist = ccdVec3Len2(&vert->v.v);
+    ccdVec3Copy(&vert->witness, &vert->v.v);
+
+    ccdListInit(&vert->edges);
+
+    // add vertex to list
+    ccdListAppend(&pt->vertices, &vert->list);
+
+    // update position in sorted array
+    ptNearestUpdate(pt, (ccd_pt_el_t *)vert);
+
+    return vert;
+}
+
+static ccd_pt_edge_t *ptAddEdge(ccd_pt_t *pt, ccd_pt_vertex_t *v1,
+                                ccd_pt_vertex_t *v2)
+{
+    const ccd_vec3_t *a, *b;
+    ccd_pt_edge_t *edge;
+
+    edge = Arena::threadLocal().allocate<ccd_pt_edge_t>(1);
+    edge->type = CCD_PT_EDGE;
+    edge->vertex[0] = v1;
+    edge->vertex[1] = v2;
+    edge->faces[0] = edge->faces[1] = NULL;
+
+    a = &edge->vertex[0]->v.v;
+    b = &edge->vertex[1]->v.v;
+    edge->dist = ccdVec3PointSegmentDist2(ccd_vec3_origin, a, b, &edge->witness);
+
+    ccdListAppend(&edge->vertex[0]->edges, &edge->vertex_list[0]);
+    ccdListAppend(&edge->vertex[1]->edges, &edge->vertex_list[1]);
+
+    ccdListAppend(&pt->edges, &edge->list);
+
+    // update position in sorted array
+    ptNearestUpdate(pt, (ccd_pt_el_t *)edge);
+
+    return edge;
+}
+
+static ccd_pt_face_t *ptAddFace(ccd_pt_t *pt, ccd_pt_edge_t *e1,
+                                ccd_pt_edge_t *e2,
+                                ccd_pt_edge_t *e3)
+{
+    const ccd_vec3_t *a, *b, *c;
+    ccd_pt_face_t *face;
+    ccd_pt_edge_t *e;
+    size_t i;
+
+    face = Arena::threadLocal().allocate<ccd_pt_face_t>(1);
+    face->type = CCD_PT_FACE;
+    face->edge[0] = e1;
+    face->edge[1] = e2;
+    face->edge[2] = e3;
+
+    // obtain triplet of vertices
+    a = &face->edge[0]->vertex[0]->v.v;
+    b = &face->edge[0]->vertex[1]->v.v;
+    e = face->edge[1];
+    if (e->vertex[0] != face->edge[0]->vertex[0]
+            && e->vertex[0] != face->edge[0]->vertex[1]){
+        c = &e->vertex[0]->v.v;
+    }else{
+        c = &e->vertex[1]->v.v;
+    }
+    face->dist = ccdVec3PointTriDist2(ccd_vec3_origin, a, b, c, &face->witness);
+
+    for (i = 0; i < 3; i++){
+        if (face->edge[i]->faces[0] == NULL){
+            face->edge[i]->faces[0] = face;
+        }else{
+            face->edge[i]->faces[1] = face;
+        }
+    }
+
+    ccdListAppend(&pt->faces, &face->list);
+
+    // update position in sorted array
+    ptNearestUpdate(pt, (ccd_pt_el_t *)face);
+
+    return face;
+}
+
+static int ptDelEdge(ccd_pt_t *pt, ccd_pt_edge_t *e)
+{
+    // text if any face is connected to this edge (faces[] is always
+    // aligned to lower indices)
+    if (e->faces[0] != NULL)
+        return -1;
+
+    // disconnect edge from lists of edges in vertex struct
+    ccdListDel(&e->vertex_list[0]);
+    ccdListDel(&e->vertex_list[1]);
+
+    // disconnect edge from main list
+    ccdListDel(&e->list);
+
+    if ((void *)pt->nearest == (void *)e){
+        pt->nearest = NULL;
+    }
+
+    return 0;
+}
+
+static int ptDelFace(ccd_pt_t *pt, ccd_pt_face_t *f)
+{
+    ccd_pt_edge_t *e;
+    size_t i;
+
+    // remove face from edges' recerence lists
+    for (i = 0; i < 3; i++){
+        e = f->edge[i];
+        if (e->faces[0] == f){
+            e->faces[0] = e->faces[1];
+        }
+        e->faces[1] = NULL;
+    }
+
+    // remove face from list of all faces
+    ccdListDel(&f->list);
+
+    if ((void *)pt->nearest == (void *)f){
+        pt->nearest = NULL;
+    }
+
+    return 0;
+}
+
 /** Transforms simplex to polytope, two vertices required */
 static int simplexToPolytope2(const void *obj1, const void *obj2,
                               const ccd_t *ccd,
@@ -508,9 +669,9 @@ static int simplexToPolytope2(const void *obj1, const void *obj2,
 
     goto simplexToPolytope2_not_touching_contact;
 simplexToPolytope2_touching_contact:
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, b);
-    *nearest = (ccd_pt_el_t *)ccdPtAddEdge(pt, v[0], v[1]);
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, b);
+    *nearest = (ccd_pt_el_t *)ptAddEdge(pt, v[0], v[1]);
     if (*nearest == NULL)
         return -2;
 
@@ -518,37 +679,37 @@ simplexToPolytope2_touching_contact:
 
 simplexToPolytope2_not_touching_contact:
     // form polyhedron
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, &supp[0]);
-    v[2] = ccdPtAddVertex(pt, b);
-    v[3] = ccdPtAddVertex(pt, &supp[1]);
-    v[4] = ccdPtAddVertex(pt, &supp[2]);
-    v[5] = ccdPtAddVertex(pt, &supp[3]);
-
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[3]);
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-
-    e[4] = ccdPtAddEdge(pt, v[4], v[0]);
-    e[5] = ccdPtAddEdge(pt, v[4], v[1]);
-    e[6] = ccdPtAddEdge(pt, v[4], v[2]);
-    e[7] = ccdPtAddEdge(pt, v[4], v[3]);
-
-    e[8]  = ccdPtAddEdge(pt, v[5], v[0]);
-    e[9]  = ccdPtAddEdge(pt, v[5], v[1]);
-    e[10] = ccdPtAddEdge(pt, v[5], v[2]);
-    e[11] = ccdPtAddEdge(pt, v[5], v[3]);
-
-    if (ccdPtAddFace(pt, e[4], e[5], e[0]) == NULL
-            || ccdPtAddFace(pt, e[5], e[6], e[1]) == NULL
-            || ccdPtAddFace(pt, e[6], e[7], e[2]) == NULL
-            || ccdPtAddFace(pt, e[7], e[4], e[3]) == NULL
-
-            || ccdPtAddFace(pt, e[8],  e[9],  e[0]) == NULL
-            || ccdPtAddFace(pt, e[9],  e[10], e[1]) == NULL
-            || ccdPtAddFace(pt, e[10], e[11], e[2]) == NULL
-            || ccdPtAddFace(pt, e[11], e[8],  e[3]) == NULL){
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, &supp[0]);
+    v[2] = ptAddVertex(pt, b);
+    v[3] = ptAddVertex(pt, &supp[1]);
+    v[4] = ptAddVertex(pt, &supp[2]);
+    v[5] = ptAddVertex(pt, &supp[3]);
+
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[3]);
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+
+    e[4] = ptAddEdge(pt, v[4], v[0]);
+    e[5] = ptAddEdge(pt, v[4], v[1]);
+    e[6] = ptAddEdge(pt, v[4], v[2]);
+    e[7] = ptAddEdge(pt, v[4], v[3]);
+
+    e[8]  = ptAddEdge(pt, v[5], v[0]);
+    e[9]  = ptAddEdge(pt, v[5], v[1]);
+    e[10] = ptAddEdge(pt, v[5], v[2]);
+    e[11] = ptAddEdge(pt, v[5], v[3]);
+
+    if (ptAddFace(pt, e[4], e[5], e[0]) == NULL
+            || ptAddFace(pt, e[5], e[6], e[1]) == NULL
+            || ptAddFace(pt, e[6], e[7], e[2]) == NULL
+            || ptAddFace(pt, e[7], e[4], e[3]) == NULL
+
+            || ptAddFace(pt, e[8],  e[9],  e[0]) == NULL
+            || ptAddFace(pt, e[9],  e[10], e[1]) == NULL
+            || ptAddFace(pt, e[10], e[11], e[2]) == NULL
+            || ptAddFace(pt, e[11], e[8],  e[3]) == NULL){
         return -2;
     }
 
@@ -594,13 +755,13 @@ static int simplexToPolytope3(const void *obj1, const void *obj2,
     // check if face isn't already on edge of minkowski sum and thus we
     // have touching contact
     if (ccdIsZero(dist) || ccdIsZero(dist2)){
-        v[0] = ccdPtAddVertex(pt, a);
-        v[1] = ccdPtAddVertex(pt, b);
-        v[2] = ccdPtAddVertex(pt, c);
-        e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-        e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-        e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-        *nearest = (ccd_pt_el_t *)ccdPtAddFace(pt, e[0], e[1], e[2]);
+        v[0] = ptAddVertex(pt, a);
+        v[1] = ptAddVertex(pt, b);
+        v[2] = ptAddVertex(pt, c);
+        e[0] = ptAddEdge(pt, v[0], v[1]);
+        e[1] = ptAddEdge(pt, v[1], v[2]);
+        e[2] = ptAddEdge(pt, v[2], v[0]);
+        *nearest = (ccd_pt_el_t *)ptAddFace(pt, e[0], e[1], e[2]);
         if (*nearest == NULL)
             return -2;
 
@@ -608,31 +769,31 @@ static int simplexToPolytope3(const void *obj1, const void *obj2,
     }
 
     // form polyhedron
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, b);
-    v[2] = ccdPtAddVertex(pt, c);
-    v[3] = ccdPtAddVertex(pt, &d);
-    v[4] = ccdPtAddVertex(pt, &d2);
-
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-    e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-    e[5] = ccdPtAddEdge(pt, v[3], v[2]);
-
-    e[6] = ccdPtAddEdge(pt, v[4], v[0]);
-    e[7] = ccdPtAddEdge(pt, v[4], v[1]);
-    e[8] = ccdPtAddEdge(pt, v[4], v[2]);
-
-    if (ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-            || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-            || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL
-
-            || ccdPtAddFace(pt, e[6], e[7], e[0]) == NULL
-            || ccdPtAddFace(pt, e[7], e[8], e[1]) == NULL
-            || ccdPtAddFace(pt, e[8], e[6], e[2]) == NULL){
+    v[0] = ptAddVertex(pt, a);
+    v[1] = ptAddVertex(pt, b);
+    v[2] = ptAddVertex(pt, c);
+    v[3] = ptAddVertex(pt, &d);
+    v[4] = ptAddVertex(pt, &d2);
+
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[0]);
+
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+    e[4] = ptAddEdge(pt, v[3], v[1]);
+    e[5] = ptAddEdge(pt, v[3], v[2]);
+
+    e[6] = ptAddEdge(pt, v[4], v[0]);
+    e[7] = ptAddEdge(pt, v[4], v[1]);
+    e[8] = ptAddEdge(pt, v[4], v[2]);
+
+    if (ptAddFace(pt, e[3], e[4], e[0]) == NULL
+            || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+            || ptAddFace(pt, e[5], e[3], e[2]) == NULL
+
+            || ptAddFace(pt, e[6], e[7], e[0]) == NULL
+            || ptAddFace(pt, e[7], e[8], e[1]) == NULL
+            || ptAddFace(pt, e[8], e[6], e[2]) == NULL){
         return -2;
     }
 
@@ -692,24 +853,24 @@ static int simplexToPolytope4(const void *obj1, const void *obj2,
 
     // no touching contact - simply create tetrahedron
     for (i = 0; i < 4; i++){
-        v[i] = ccdPtAddVertex(pt, ccdSimplexPoint(simplex, i));
+        v[i] = ptAddVertex(pt, ccdSimplexPoint(simplex, i));
     }
 
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-    e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-    e[5] = ccdPtAddEdge(pt, v[3], v[2]);
+    e[0] = ptAddEdge(pt, v[0], v[1]);
+    e[1] = ptAddEdge(pt, v[1], v[2]);
+    e[2] = ptAddEdge(pt, v[2], v[0]);
+    e[3] = ptAddEdge(pt, v[3], v[0]);
+    e[4] = ptAddEdge(pt, v[3], v[1]);
+    e[5] = ptAddEdge(pt, v[3], v[2]);
 
     // ccdPtAdd*() functions return NULL either if the memory allocation
     // failed of if any of the input pointers are NULL, so the bad
-    // allocation can be checked by the last calls of ccdPtAddFace()
+    // allocation can be checked by the last calls of ptAddFace()
     // because the rest of the bad allocations eventually "bubble up" here
-    if (ccdPtAddFace(pt, e[0], e[1], e[2]) == NULL
-            || ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-            || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-            || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL){
+    if (ptAddFace(pt, e[0], e[1], e[2]) == NULL
+            || ptAddFace(pt, e[3], e[4], e[0]) == NULL
+            || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+            || ptAddFace(pt, e[5], e[3], e[2]) == NULL){
         return -2;
     }
 
@@ -785,35 +946,35 @@ static int expandPolytope(ccd_pt_t *pt, ccd_pt_el_t *el,
             }
 
 
-            v[4] = ccdPtAddVertex(pt, newv);
+            v[4] = ptAddVertex(pt, newv);
 
-            ccdPtDelFace(pt, f[0]);
+            ptDelFace(pt, f[0]);
             if (f[1]){
-                ccdPtDelFace(pt, f[1]);
-                ccdPtDelEdge(pt, (ccd_pt_edge_t *)el);
+                ptDelFace(pt, f[1]);
+                ptDelEdge(pt, (ccd_pt_edge_t *)el);
             }
 
-            e[4] = ccdPtAddEdge(pt, v[4], v[2]);
-            e[5] = ccdPtAddEdge(pt, v[4], v[0]);
-            e[6] = ccdPtAddEdge(pt, v[4], v[1]);
+            e[4] = ptAddEdge(pt, v[4], v[2]);
+            e[5] = ptAddEdge(pt, v[4], v[0]);
+            e[6] = ptAddEdge(pt, v[4], v[1]);
             if (f[1])
-                e[7] = ccdPtAddEdge(pt, v[4], v[3]);
+                e[7] = ptAddEdge(pt, v[4], v[3]);
 
 
-            if (ccdPtAddFace(pt, e[1], e[4], e[6]) == NULL
-                    || ccdPtAddFace(pt, e[0], e[6], e[5]) == NULL){
+            if (ptAddFace(pt, e[1], e[4], e[6]) == NULL
+                    || ptAddFace(pt, e[0], e[6], e[5]) == NULL){
                 return -2;
             }
 
             if (f[1]){
                 FCL_SUPPRESS_MAYBE_UNINITIALIZED_BEGIN
-                if (ccdPtAddFace(pt, e[3], e[5], e[7]) == NULL
-                        || ccdPtAddFace(pt, e[4], e[7], e[2]) == NULL){
+                if (ptAddFace(pt, e[3], e[5], e[7]) == NULL
+                        || ptAddFace(pt, e[4], e[7], e[2]) == NULL){
                     return -2;
                 }
                 FCL_SUPPRESS_MAYBE_UNINITIALIZED_END
             }else{
-                if (ccdPtAddFace(pt, e[4], e[5], (ccd_pt_edge_t *)el) == NULL)
+                if (ptAddFace(pt, e[4], e[5], (ccd_pt_edge_t *)el) == NULL)
                     return -2;
             }
         }
@@ -838,17 +999,17 @@ static int expandPolytope(ccd_pt_t *pt, ccd_pt_el_t *el,
             v[2] = v[3];
 
         // remove triangle face
-        ccdPtDelFace(pt, (ccd_pt_face_t *)el);
+        ptDelFace(pt, (ccd_pt_face_t *)el);
 
         // expand triangle to tetrahedron
-        v[3] = ccdPtAddVertex(pt, newv);
-        e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-        e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-        e[5] = ccdPtAddEdge(pt, v[3], v[2]);
-
-        if (ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL
-                || ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL
-                || ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL){
+        v[3] = ptAddVertex(pt, newv);
+        e[3] = ptAddEdge(pt, v[3], v[0]);
+        e[4] = ptAddEdge(pt, v[3], v[1]);
+        e[5] = ptAddEdge(pt, v[3], v[2]);
+
+        if (ptAddFace(pt, e[3], e[4], e[0]) == NULL
+                || ptAddFace(pt, e[4], e[5], e[1]) == NULL
+                || ptAddFace(pt, e[5], e[3], e[2]) == NULL){
             return -2;
         }
     }
@@ -1261,9 +1422,7 @@ static int penEPAPosClosest(const ccd_pt_t *pt, const ccd_pt_el_t *nearest,
         len++;
     }
 
-    vs = CCD_ALLOC_ARR(ccd_pt_vertex_t*, len);
-    if (vs == NULL)
-        return -1;
+    vs = Arena::threadLocal().allocate<ccd_pt_vertex_t*>(len);
 
     i = 0;
     ccdListForEachEntry(&pt->vertices, v, ccd_pt_vertex_t, list){
@@ -1275,8 +1434,6 @@ static int penEPAPosClosest(const ccd_pt_t *pt, const ccd_pt_el_t *nearest,
     ccdVec3Copy(p1, &vs[0]->v.v1);
     ccdVec3Copy(p2, &vs[0]->v.v2);
 
-    free(vs);
-
     return 0;
 }
 
@@ -1286,6 +1443,10 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, co
 
   if (__ccdGJK(obj1, obj2, ccd, &simplex) == 0) // in collision, then using the EPA
   {
+    // The polytope lives in the arena of the thread and is given back at once
+    // when the scope ends
+    Arena::Scope scope(Arena::threadLocal());
+
     ccd_pt_t polytope;
     ccd_pt_el_t *nearest;
     ccd_real_t depth;
@@ -1316,8 +1477,6 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2, co
       depth = -CCD_ONE;
     }
 
-    ccdPtDestroy(&polytope);
-
     return depth;
   }
   else // not in collision
@@ -1473,6 +1632,7 @@ static void convexToGJK(const Convex<S>& s, const Transform3<S>& tf, ccd_convex_
 {
   shapeToGJK(s, tf, conv);
   conv->convex = &s;
+  conv->support_hint = 0;
 }
 
 /** Support functions */
@@ -1618,29 +1778,19 @@ static inline void supportEllipsoid(const void* obj, const ccd_vec3_t* dir_, ccd
 template <typename S>
 static void supportConvex(const void* obj, const ccd_vec3_t* dir_, ccd_vec3_t* v)
 {
-  const auto* c = (const ccd_convex_t<S>*)obj;
-  ccd_vec3_t dir, p;
-  ccd_real_t maxdot, dot;
-  int i;
-  Vector3<S>* curp;
-  const auto& center = c->convex->center;
+  // libccd passes the object as const, but it is created per query and only
+  // the warm start of the next support query is written
+  auto* c = (ccd_convex_t<S>*)obj;
+  ccd_vec3_t dir;
 
   ccdVec3Copy(&dir, dir_);
   ccdQuatRotVec(&dir, &c->rot_inv);
 
-  maxdot = -CCD_REAL_MAX;
-  curp = c->convex->points;
-
-  for(i = 0; i < c->convex->num_points; ++i, curp += 1)
-  {
-    ccdVec3Set(&p, (*curp)[0] - center[0], (*curp)[1] - center[1], (*curp)[2] - center[2]);
-    dot = ccdVec3Dot(&dir, &p);
-    if(dot > maxdot)
-    {
-      ccdVec3Set(v, (*curp)[0], (*curp)[1], (*curp)[2]);
-      maxdot = dot;
-    }
-  }
+  c->support_hint = c->convex->findExtremeVertex(
+      Vector3<S>(ccdVec3X(&dir), ccdVec3Y(&dir), ccdVec3Z(&dir)),
+      c->support_hint);
+  const Vector3<S>& p = c->convex->points[c->support_hint];
+  ccdVec3Set(v, p[0], p[1], p[2]);
 
   // transform support vertex
   ccdQuatRotVec(v, &c->rot);
@@ -53,6 +53,15 @@ Vector3<S> getSupport(
     const ShapeBase<S>* shape,
     const Eigen::MatrixBase<Derived>& dir);
 
+/// @brief the support function for shape, where hint is the index of the
+/// support vertex of a previous query that is used to warm start the search
+/// on Convex shapes, and is set to the index of the new support vertex
+template <typename S, typename Derived>
+Vector3<S> getSupport(
+    const ShapeBase<S>* shape,
+    const Eigen::MatrixBase<Derived>& dir,
+    int& hint);
+
 /// @brief Minkowski difference class of two shapes
 template <typename S>
 struct FCL_EXPORT MinkowskiDiff
@@ -66,6 +75,9 @@ struct FCL_EXPORT MinkowskiDiff
   /// @brief transform from shape1 to shape0 
   Transform3<S> toshape0;
 
+  /// @brief last support vertex of each shape, for the shapes that have them
+  mutable int support_hints[2];
+
   MinkowskiDiff();
 
   /// @brief support function for shape0
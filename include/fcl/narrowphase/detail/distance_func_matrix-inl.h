@@ -219,9 +219,14 @@ typename Shape1::S ShapeShapeDistance(
   const Shape1* obj1 = static_cast<const Shape1*>(o1);
   const Shape2* obj2 = static_cast<const Shape2*>(o2);
 
+  if(request.gjk_cache)
+    nsolver->setGJKWarmStart(&request.gjk_cache->get(o1, o2));
+
   initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
   distance(&node);
 
+  nsolver->setGJKWarmStart(nullptr);
+
   return result.min_distance;
 }
 
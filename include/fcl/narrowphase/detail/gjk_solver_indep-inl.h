@@ -118,6 +118,7 @@ struct ShapeIntersectIndepImpl
   {
     Vector3<S> guess(1, 0, 0);
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
+    if(gjkSolver.gjk_warm_start && gjkSolver.gjk_warm_start->rank) guess = gjkSolver.gjk_warm_start->axis;
 
     detail::MinkowskiDiff<S> shape;
     shape.shapes[0] = &s1;
@@ -126,8 +127,9 @@ struct ShapeIntersectIndepImpl
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
-    typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess, gjkSolver.gjk_warm_start);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
+    if(gjkSolver.gjk_warm_start) gjk.getWarmStart(*gjkSolver.gjk_warm_start);
 
     switch(gjk_status)
     {
@@ -595,6 +597,7 @@ struct ShapeDistanceIndepImpl
   {
     Vector3<S> guess(1, 0, 0);
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
+    if(gjkSolver.gjk_warm_start && gjkSolver.gjk_warm_start->rank) guess = gjkSolver.gjk_warm_start->axis;
 
     detail::MinkowskiDiff<S> shape;
     shape.shapes[0] = &s1;
@@ -603,8 +606,9 @@ struct ShapeDistanceIndepImpl
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
     detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
-    typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+    typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess, gjkSolver.gjk_warm_start);
     if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
+    if(gjkSolver.gjk_warm_start) gjk.getWarmStart(*gjkSolver.gjk_warm_start);
 
     if(gjk_status == detail::GJK<S>::Valid)
     {
@@ -955,6 +959,7 @@ GJKSolver_indep<S>::GJKSolver_indep()
   epa_tolerance = 1e-6;
   enable_cached_guess = false;
   cached_guess = Vector3<S>(1, 0, 0);
+  gjk_warm_start = nullptr;
 }
 
 //==============================================================================
@@ -971,6 +976,13 @@ void GJKSolver_indep<S>::setCachedGuess(const Vector3<S>& guess) const
   cached_guess = guess;
 }
 
+//==============================================================================
+template <typename S>
+void GJKSolver_indep<S>::setGJKWarmStart(GJKWarmStart<S>* warm_start) const
+{
+  gjk_warm_start = warm_start;
+}
+
 //==============================================================================
 template <typename S>
 Vector3<S> GJKSolver_indep<S>::getCachedGuess() const
@@ -40,6 +40,7 @@
 
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact_point.h"
+#include "fcl/narrowphase/gjk_cache.h"
 
 namespace fcl
 {
@@ -156,6 +157,10 @@ struct FCL_EXPORT GJKSolver_indep
 
   Vector3<S> getCachedGuess() const;
 
+  /// @brief Warm start the following shape-shape queries from warm_start and
+  /// store their final state in it; nullptr to stop
+  void setGJKWarmStart(GJKWarmStart<S>* warm_start) const;
+
   /// @brief maximum number of simplex face used in EPA algorithm
   unsigned int epa_max_face_num;
 
@@ -179,6 +184,9 @@ struct FCL_EXPORT GJKSolver_indep
 
   /// @brief smart guess
   mutable Vector3<S> cached_guess;
+
+  /// @brief warm start of the shape-shape queries, if any
+  mutable GJKWarmStart<S>* gjk_warm_start;
 };
 
 using GJKSolver_indepf = GJKSolver_indep<float>;
@@ -925,6 +925,15 @@ void GJKSolver_libccd<S>::setCachedGuess(
   // TODO: need change libccd to exploit spatial coherence
 }
 
+//==============================================================================
+template<typename S>
+void GJKSolver_libccd<S>::setGJKWarmStart(GJKWarmStart<S>* warm_start) const
+{
+  FCL_UNUSED(warm_start);
+
+  // TODO: need change libccd to exploit spatial coherence
+}
+
 //==============================================================================
 template<typename S>
 Vector3<S> GJKSolver_libccd<S>::getCachedGuess() const
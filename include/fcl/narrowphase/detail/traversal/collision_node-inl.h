@@ -51,6 +51,18 @@ namespace detail
 extern template
 void collide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
 
+//==============================================================================
+extern template
+void collide(MeshCollisionTraversalNodeOBB<double>* node, BVHFrontList* front_list);
+
+//==============================================================================
+extern template
+void collide(MeshCollisionTraversalNodeRSS<double>* node, BVHFrontList* front_list);
+
+//==============================================================================
+extern template
+void collide(MeshCollisionTraversalNodeOBBRSS<double>* node, BVHFrontList* front_list);
+
 //==============================================================================
 extern template
 void selfCollide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
@@ -59,6 +71,14 @@ void selfCollide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_l
 extern template
 void distance(DistanceTraversalNodeBase<double>* node, BVHFrontList* front_list, int qsize);
 
+//==============================================================================
+extern template
+void distance(MeshDistanceTraversalNodeRSS<double>* node, BVHFrontList* front_list, int qsize);
+
+//==============================================================================
+extern template
+void distance(MeshDistanceTraversalNodeOBBRSS<double>* node, BVHFrontList* front_list, int qsize);
+
 //==============================================================================
 extern template
 void collide2(MeshCollisionTraversalNodeOBB<double>* node, BVHFrontList* front_list);
@@ -81,6 +101,48 @@ void collide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
   }
 }
 
+//==============================================================================
+template <typename S>
+void collide(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list)
+{
+  if(front_list)
+  {
+    collide(static_cast<CollisionTraversalNodeBase<S>*>(node), front_list);
+  }
+  else if(!node->BVTesting(0, 0))
+  {
+    orientedCollisionRecurse(node, node->R, node->T);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void collide(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list)
+{
+  if(front_list)
+  {
+    collide(static_cast<CollisionTraversalNodeBase<S>*>(node), front_list);
+  }
+  else if(!node->BVTesting(0, 0))
+  {
+    orientedCollisionRecurse(node, node->R, node->T);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void collide(MeshCollisionTraversalNodeOBBRSS<S>* node, BVHFrontList* front_list)
+{
+  if(front_list)
+  {
+    collide(static_cast<CollisionTraversalNodeBase<S>*>(node), front_list);
+  }
+  else if(!node->BVTesting(0, 0))
+  {
+    orientedCollisionRecurse(node, node->R, node->T);
+  }
+}
+
 //==============================================================================
 template <typename S>
 void collide2(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list)
@@ -146,6 +208,36 @@ void distance(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list, int
   node->postprocess();
 }
 
+//==============================================================================
+template <typename S>
+void distance(MeshDistanceTraversalNodeRSS<S>* node, BVHFrontList* front_list, int qsize)
+{
+  if(front_list || qsize > 2)
+  {
+    distance(static_cast<DistanceTraversalNodeBase<S>*>(node), front_list, qsize);
+    return;
+  }
+
+  node->preprocess();
+  orientedDistanceRecurse(node);
+  node->postprocess();
+}
+
+//==============================================================================
+template <typename S>
+void distance(MeshDistanceTraversalNodeOBBRSS<S>* node, BVHFrontList* front_list, int qsize)
+{
+  if(front_list || qsize > 2)
+  {
+    distance(static_cast<DistanceTraversalNodeBase<S>*>(node), front_list, qsize);
+    return;
+  }
+
+  node->preprocess();
+  orientedDistanceRecurse(node);
+  node->postprocess();
+}
+
 } // namespace detail
 } // namespace fcl
 
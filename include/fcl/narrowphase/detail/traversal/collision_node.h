@@ -56,6 +56,24 @@ template <typename S>
 FCL_EXPORT
 void collide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list = nullptr);
 
+/// @brief collision on OBB traversal node; uses orientedCollisionRecurse()
+/// unless a front list is given
+template <typename S>
+FCL_EXPORT
+void collide(MeshCollisionTraversalNodeOBB<S>* node, BVHFrontList* front_list = nullptr);
+
+/// @brief collision on RSS traversal node; uses orientedCollisionRecurse()
+/// unless a front list is given
+template <typename S>
+FCL_EXPORT
+void collide(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list = nullptr);
+
+/// @brief collision on OBBRSS traversal node; uses orientedCollisionRecurse()
+/// unless a front list is given
+template <typename S>
+FCL_EXPORT
+void collide(MeshCollisionTraversalNodeOBBRSS<S>* node, BVHFrontList* front_list = nullptr);
+
 /// @brief self collision on collision traversal node; can use front list to accelerate
 template <typename S>
 FCL_EXPORT
@@ -66,6 +84,18 @@ template <typename S>
 FCL_EXPORT
 void distance(DistanceTraversalNodeBase<S>* node, BVHFrontList* front_list = nullptr, int qsize = 2);
 
+/// @brief distance computation on RSS distance traversal node; uses
+/// orientedDistanceRecurse() unless a front list or a queue is requested
+template <typename S>
+FCL_EXPORT
+void distance(MeshDistanceTraversalNodeRSS<S>* node, BVHFrontList* front_list = nullptr, int qsize = 2);
+
+/// @brief distance computation on OBBRSS distance traversal node; uses
+/// orientedDistanceRecurse() unless a front list or a queue is requested
+template <typename S>
+FCL_EXPORT
+void distance(MeshDistanceTraversalNodeOBBRSS<S>* node, BVHFrontList* front_list = nullptr, int qsize = 2);
+
 /// @brief special collision on OBB traversal node
 template <typename S>
 FCL_EXPORT
@@ -40,9 +40,11 @@
 
 #include "fcl/narrowphase/detail/traversal/traversal_recurse.h"
 
+#include <algorithm>
 #include <queue>
 
 #include "fcl/common/unused.h"
+#include "fcl/math/bv/utility.h"
 
 namespace fcl
 {
@@ -62,6 +64,54 @@ void collisionRecurse(MeshCollisionTraversalNodeOBB<double>* node, int b1, int b
 extern template
 void collisionRecurse(MeshCollisionTraversalNodeRSS<double>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T, BVHFrontList* front_list);
 
+//==============================================================================
+extern template
+void collisionRecursePacket(MeshCollisionTraversalNode<OBB<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecursePacket(MeshCollisionTraversalNode<RSS<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecursePacket(MeshCollisionTraversalNode<OBBRSS<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBB<double>>* node, const WideBVH<OBB<double>, 4>& wide1, const WideBVH<OBB<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBB<double>>* node, const WideBVH<OBB<double>, 8>& wide1, const WideBVH<OBB<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 4>& wide1, const WideBVH<RSS<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 8>& wide1, const WideBVH<RSS<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 4>& wide1, const WideBVH<OBBRSS<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 8>& wide1, const WideBVH<OBBRSS<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<OBB<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<RSS<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+extern template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<OBBRSS<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
 //==============================================================================
 extern template
 void selfCollisionRecurse(CollisionTraversalNodeBase<double>* node, int b, BVHFrontList* front_list);
@@ -74,6 +124,30 @@ void distanceRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b2, BV
 extern template
 void distanceQueueRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b2, BVHFrontList* front_list, int qsize);
 
+//==============================================================================
+extern template
+void distanceRecurseWide(MeshDistanceTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 4>& wide1, const WideBVH<RSS<double>, 4>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+extern template
+void distanceRecurseWide(MeshDistanceTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 8>& wide1, const WideBVH<RSS<double>, 8>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+extern template
+void distanceRecurseWide(MeshDistanceTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 4>& wide1, const WideBVH<OBBRSS<double>, 4>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+extern template
+void distanceRecurseWide(MeshDistanceTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 8>& wide1, const WideBVH<OBBRSS<double>, 8>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+extern template
+void orientedDistanceRecurse(MeshDistanceTraversalNode<RSS<double>>* node);
+
+//==============================================================================
+extern template
+void orientedDistanceRecurse(MeshDistanceTraversalNode<OBBRSS<double>>* node);
+
 //==============================================================================
 extern template
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
@@ -229,6 +303,226 @@ void collisionRecurse(MeshCollisionTraversalNodeRSS<S>* node, int b1, int b2, co
   // Do nothing
 }
 
+//==============================================================================
+/** @brief Exact overlap test of a pair of leaf bounding volumes that passed
+ * the packet test of their enclosing oriented boxes */
+template <typename S>
+FCL_EXPORT
+bool overlapAfterPacketTest(const Matrix3<S>& R, const Vector3<S>& T, const OBB<S>& b1, const OBB<S>& b2)
+{
+  FCL_UNUSED(R);
+  FCL_UNUSED(T);
+  FCL_UNUSED(b1);
+  FCL_UNUSED(b2);
+
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool overlapAfterPacketTest(const Matrix3<S>& R, const Vector3<S>& T, const RSS<S>& b1, const RSS<S>& b2)
+{
+  return overlap(R, T, b1, b2);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT
+bool overlapAfterPacketTest(const Matrix3<S>& R, const Vector3<S>& T, const OBBRSS<S>& b1, const OBBRSS<S>& b2)
+{
+  FCL_UNUSED(R);
+  FCL_UNUSED(T);
+  FCL_UNUSED(b1);
+  FCL_UNUSED(b2);
+
+  return true;
+}
+
+//==============================================================================
+template <typename BV, int N>
+FCL_EXPORT
+void collisionRecursePacket(MeshCollisionTraversalNode<BV>* node, int b1, int b2, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T)
+{
+  using S = typename BV::S;
+
+  bool l1 = node->isFirstNodeLeaf(b1);
+  bool l2 = node->isSecondNodeLeaf(b2);
+
+  if(l1 && l2)
+  {
+    node->leafTesting(b1, b2);
+    return;
+  }
+
+  // Descend the tree chosen by firstOverSecond() breadth first, keeping the
+  // candidates in depth first order, until there are N of them or all of
+  // them are leaves. The node itself is never a candidate as it is known to
+  // overlap.
+  const bool descend_first = node->firstOverSecond(b1, b2);
+  const BVHModel<BV>* model = descend_first ? node->model1 : node->model2;
+
+  int candidates[N];
+  int num_candidates = 1;
+  candidates[0] = descend_first ? b1 : b2;
+
+  while(num_candidates < N)
+  {
+    int num_expanded = 0;
+    int expanded[N];
+    int budget = N - num_candidates;
+
+    for(int i = 0; i < num_candidates; ++i)
+    {
+      const BVNode<BV>& bvnode = model->getBV(candidates[i]);
+      if(budget > 0 && !bvnode.isLeaf())
+      {
+        expanded[num_expanded++] = bvnode.leftChild();
+        expanded[num_expanded++] = bvnode.rightChild();
+        --budget;
+      }
+      else
+      {
+        expanded[num_expanded++] = candidates[i];
+      }
+    }
+
+    if(num_expanded == num_candidates)
+      break;
+
+    std::copy(expanded, expanded + num_expanded, candidates);
+    num_candidates = num_expanded;
+  }
+
+  OBBPacket<S, N> packet;
+  OBB<S> box;
+  for(int i = 0; i < num_candidates; ++i)
+  {
+    computeBoundingOBB(model->getBV(candidates[i]).bv, box);
+    packet.push_back(box);
+  }
+
+  // The packet test takes the candidates in the frame of the other box, so
+  // descending the first tree needs the configuration of the first model
+  // relative to the second one.
+  Eigen::Array<bool, N, 1> disjoint;
+  if(descend_first)
+  {
+    const Matrix3<S> Rinv = R.transpose();
+    const Vector3<S> Tinv = -(Rinv * T);
+    computeBoundingOBB(node->model2->getBV(b2).bv, box);
+    disjoint = obbDisjoint(Rinv, Tinv, box, packet);
+  }
+  else
+  {
+    computeBoundingOBB(node->model1->getBV(b1).bv, box);
+    disjoint = obbDisjoint(R, T, box, packet);
+  }
+
+  if(node->enable_statistics) node->num_bv_tests += num_candidates;
+
+  for(int i = 0; i < num_candidates; ++i)
+  {
+    if(disjoint[i])
+      continue;
+
+    const int c1 = descend_first ? candidates[i] : b1;
+    const int c2 = descend_first ? b2 : candidates[i];
+
+    // Inner pairs are only pruned by the enclosing boxes, which is cheaper
+    // overall than refining every one of them
+    if(node->isFirstNodeLeaf(c1) && node->isSecondNodeLeaf(c2)
+       && !overlapAfterPacketTest(R, T, node->model1->getBV(c1).bv, node->model2->getBV(c2).bv))
+      continue;
+
+    collisionRecursePacket<BV, N>(node, c1, c2, R, T);
+
+    if(node->canStop()) return;
+  }
+}
+
+//==============================================================================
+template <typename BV, int N>
+FCL_EXPORT
+void collisionRecurseWide(MeshCollisionTraversalNode<BV>* node, const WideBVH<BV, N>& wide1, const WideBVH<BV, N>& wide2, int b1, int w1, int b2, int w2, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T)
+{
+  using S = typename BV::S;
+
+  if(w1 < 0 && w2 < 0)
+  {
+    node->leafTesting(b1, b2);
+    return;
+  }
+
+  // firstOverSecond() never picks a leaf while the other node is inner
+  const bool descend_first = node->firstOverSecond(b1, b2);
+  const WideBVNode<S, N>& wnode = descend_first ? wide1.getNode(w1) : wide2.getNode(w2);
+
+  OBB<S> box;
+  Eigen::Array<bool, N, 1> disjoint;
+  if(descend_first)
+  {
+    const Matrix3<S> Rinv = R.transpose();
+    const Vector3<S> Tinv = -(Rinv * T);
+    computeBoundingOBB(node->model2->getBV(b2).bv, box);
+    disjoint = obbDisjoint(Rinv, Tinv, box, wnode.bounds);
+  }
+  else
+  {
+    computeBoundingOBB(node->model1->getBV(b1).bv, box);
+    disjoint = obbDisjoint(R, T, box, wnode.bounds);
+  }
+
+  if(node->enable_statistics) node->num_bv_tests += wnode.num_children;
+
+  for(int i = 0; i < wnode.num_children; ++i)
+  {
+    if(disjoint[i])
+      continue;
+
+    const int c1 = descend_first ? wnode.bv_index[i] : b1;
+    const int v1 = descend_first ? wnode.child[i] : w1;
+    const int c2 = descend_first ? b2 : wnode.bv_index[i];
+    const int v2 = descend_first ? w2 : wnode.child[i];
+
+    if(v1 < 0 && v2 < 0
+       && !overlapAfterPacketTest(R, T, node->model1->getBV(c1).bv, node->model2->getBV(c2).bv))
+      continue;
+
+    collisionRecurseWide<BV, N>(node, wide1, wide2, c1, v1, c2, v2, R, T);
+
+    if(node->canStop()) return;
+  }
+}
+
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+void orientedCollisionRecurse(MeshCollisionTraversalNode<BV>* node, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T)
+{
+  // The root of a model stands for the wide node 0 unless it is a leaf
+  const int w1 = node->model1->getBV(0).isLeaf() ? -1 : 0;
+  const int w2 = node->model2->getBV(0).isLeaf() ? -1 : 0;
+
+  const WideBVH<BV, 8>* wide8_1 = node->model1->getWideBVH8();
+  const WideBVH<BV, 8>* wide8_2 = node->model2->getWideBVH8();
+  if(wide8_1 && wide8_2)
+  {
+    collisionRecurseWide(node, *wide8_1, *wide8_2, 0, w1, 0, w2, R, T);
+    return;
+  }
+
+  const WideBVH<BV, 4>* wide4_1 = node->model1->getWideBVH4();
+  const WideBVH<BV, 4>* wide4_2 = node->model2->getWideBVH4();
+  if(wide4_1 && wide4_2)
+  {
+    collisionRecurseWide(node, *wide4_1, *wide4_2, 0, w1, 0, w2, R, T);
+    return;
+  }
+
+  collisionRecursePacket(node, 0, 0, R, T);
+}
+
 //==============================================================================
 /** Recurse function for self collision
  * Make sure node is set correctly so that the first and second tree are the same
@@ -459,6 +753,75 @@ void distanceQueueRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BV
   }
 }
 
+//==============================================================================
+template <typename BV, int N>
+FCL_EXPORT
+void distanceRecurseWide(MeshDistanceTraversalNode<BV>* node, const WideBVH<BV, N>& wide1, const WideBVH<BV, N>& wide2, int b1, int w1, int b2, int w2)
+{
+  using S = typename BV::S;
+
+  if(w1 < 0 && w2 < 0)
+  {
+    node->leafTesting(b1, b2);
+    return;
+  }
+
+  const bool descend_first = node->firstOverSecond(b1, b2);
+  const WideBVNode<S, N>& wnode = descend_first ? wide1.getNode(w1) : wide2.getNode(w2);
+
+  S d[N];
+  int order[N];
+  for(int i = 0; i < wnode.num_children; ++i)
+  {
+    d[i] = descend_first ? node->BVTesting(wnode.bv_index[i], b2) : node->BVTesting(b1, wnode.bv_index[i]);
+
+    // Insertion sort, closest first
+    int j = i;
+    for(; j > 0 && d[order[j - 1]] > d[i]; --j)
+      order[j] = order[j - 1];
+    order[j] = i;
+  }
+
+  for(int k = 0; k < wnode.num_children; ++k)
+  {
+    const int i = order[k];
+    if(node->canStop(d[i]))
+      return;
+
+    if(descend_first)
+      distanceRecurseWide<BV, N>(node, wide1, wide2, wnode.bv_index[i], wnode.child[i], b2, w2);
+    else
+      distanceRecurseWide<BV, N>(node, wide1, wide2, b1, w1, wnode.bv_index[i], wnode.child[i]);
+  }
+}
+
+//==============================================================================
+template <typename BV>
+FCL_EXPORT
+void orientedDistanceRecurse(MeshDistanceTraversalNode<BV>* node)
+{
+  const int w1 = node->model1->getBV(0).isLeaf() ? -1 : 0;
+  const int w2 = node->model2->getBV(0).isLeaf() ? -1 : 0;
+
+  const WideBVH<BV, 8>* wide8_1 = node->model1->getWideBVH8();
+  const WideBVH<BV, 8>* wide8_2 = node->model2->getWideBVH8();
+  if(wide8_1 && wide8_2)
+  {
+    distanceRecurseWide(node, *wide8_1, *wide8_2, 0, w1, 0, w2);
+    return;
+  }
+
+  const WideBVH<BV, 4>* wide4_1 = node->model1->getWideBVH4();
+  const WideBVH<BV, 4>* wide4_2 = node->model2->getWideBVH4();
+  if(wide4_1 && wide4_2)
+  {
+    distanceRecurseWide(node, *wide4_1, *wide4_2, 0, w1, 0, w2);
+    return;
+  }
+
+  distanceRecurse(node, 0, 0, nullptr);
+}
+
 //==============================================================================
 template <typename S>
 FCL_EXPORT
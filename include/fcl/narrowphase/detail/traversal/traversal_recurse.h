@@ -39,10 +39,12 @@
 #define FCL_TRAVERSAL_RECURSE_H
 
 #include "fcl/geometry/bvh/detail/BVH_front.h"
+#include "fcl/math/bv/OBB_packet.h"
 #include "fcl/narrowphase/detail/traversal/traversal_node_base.h"
 #include "fcl/narrowphase/detail/traversal/collision/collision_traversal_node_base.h"
 #include "fcl/narrowphase/detail/traversal/collision/mesh_collision_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/distance/distance_traversal_node_base.h"
+#include "fcl/narrowphase/detail/traversal/distance/mesh_distance_traversal_node.h"
 
 namespace fcl
 {
@@ -65,6 +67,34 @@ template <typename S>
 FCL_EXPORT
 void collisionRecurse(MeshCollisionTraversalNodeRSS<S>* node, int b1, int b2, const Matrix3<S>& R, const Vector3<S>& T, BVHFrontList* front_list);
 
+/// @brief Recurse function for collision between two meshes whose bounding
+/// volumes are oriented boxes or contained in them (OBB, RSS and OBBRSS), for
+/// which (R, T) is the configuration of the second model relative to the
+/// first one. Rather than testing child pairs one by one, the node of one tree
+/// is tested against up to N nodes of the other tree (found by descending the
+/// latter breadth first) with a single OBBPacket test. The bounding volumes of
+/// b1 and b2 are expected to overlap. RSS leaf pairs are checked with the
+/// exact RSS test before the leaf test. Front lists are not supported.
+template <typename BV, int N = 4>
+FCL_EXPORT
+void collisionRecursePacket(MeshCollisionTraversalNode<BV>* node, int b1, int b2, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T);
+
+/// @brief Recurse function for collision between two meshes that both have a
+/// wide hierarchy of width N (see BVHModel::buildWideBVH()). Same as
+/// collisionRecursePacket(), except that the packets are the prepacked
+/// children of the wide nodes. w1 and w2 are the wide nodes standing for b1
+/// and b2, or -1 if b1 or b2 is a leaf.
+template <typename BV, int N>
+FCL_EXPORT
+void collisionRecurseWide(MeshCollisionTraversalNode<BV>* node, const WideBVH<BV, N>& wide1, const WideBVH<BV, N>& wide2, int b1, int w1, int b2, int w2, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T);
+
+/// @brief Collision between two meshes with OBB, RSS or OBBRSS bounding
+/// volumes from their overlapping roots. The wide hierarchies are traversed
+/// if both models have ones of the same width, the binary ones otherwise.
+template <typename BV>
+FCL_EXPORT
+void orientedCollisionRecurse(MeshCollisionTraversalNode<BV>* node, const Matrix3<typename BV::S>& R, const Vector3<typename BV::S>& T);
+
 /// @brief Recurse function for self collision. Make sure node is set correctly so that the first and second tree are the same
 template <typename S>
 FCL_EXPORT
@@ -80,6 +110,25 @@ template <typename S>
 FCL_EXPORT
 void distanceQueueRecurse(DistanceTraversalNodeBase<S>* node, int b1, int b2, BVHFrontList* front_list, int qsize);
 
+/// @brief Recurse function for distance between two meshes that both have a
+/// wide hierarchy of width N. The children of the descended wide node are
+/// visited closest first, and the remaining ones are skipped as soon as their
+/// bounding volume distance cannot improve the result. w1 and w2 are the wide
+/// nodes standing for b1 and b2, or -1 if b1 or b2 is a leaf.
+/// The children are still bounded one at a time with the exact scalar
+/// BVTesting(); there is no packet distance kernel, so the gain over
+/// distanceRecurse() comes from the shallower tree and the ordering only.
+template <typename BV, int N>
+FCL_EXPORT
+void distanceRecurseWide(MeshDistanceTraversalNode<BV>* node, const WideBVH<BV, N>& wide1, const WideBVH<BV, N>& wide2, int b1, int w1, int b2, int w2);
+
+/// @brief Distance between two meshes from their roots. The wide hierarchies
+/// are traversed if both models have ones of the same width, the binary ones
+/// with distanceRecurse() otherwise.
+template <typename BV>
+FCL_EXPORT
+void orientedDistanceRecurse(MeshDistanceTraversalNode<BV>* node);
+
 /// @brief Recurse function for front list propagation
 template <typename S>
 FCL_EXPORT
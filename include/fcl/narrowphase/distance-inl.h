@@ -60,6 +60,32 @@ double distance(
     const CollisionGeometry<double>* o2, const Transform3<double>& tf2,
     const DistanceRequest<double>& request, DistanceResult<double>& result);
 
+//==============================================================================
+extern template
+double distanceBatch(
+    const std::vector<CollisionObjectPair<double>>& pairs,
+    const DistanceRequest<double>& request,
+    std::vector<DistanceResult<double>>& results,
+    ThreadPool* pool);
+
+namespace detail
+{
+
+/// @brief Replaces the negative distance of a penetrating pair by the maximum
+/// penetration depth found by the collision routine, for the shape types that
+/// have no native signed distance support.
+template <typename NarrowPhaseSolver>
+void computeSignedDistanceFromPenetration(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result);
+
+} // namespace detail
+
 //==============================================================================
 template <typename GJKSolver>
 detail::DistanceFunctionMatrix<GJKSolver>& getDistanceFunctionLookTable()
@@ -137,59 +163,132 @@ typename NarrowPhaseSolver::S distance(
     }
   }
 
-  // TODO(JS): FCL supports negative distance calculation only for OT_GEOM shape
-  // types (i.e., primitive shapes like sphere, cylinder, box, and so on). As a
-  // workaround for the rest shape types like mesh and octree, following
-  // computes negative distance using additional penetration depth computation
-  // of collision checking routine. The downside of this workaround is that the
-  // pair of nearest points is not guaranteed to be on the surface of the
-  // objects.
   if(res
      && result.min_distance < static_cast<S>(0)
      && request.enable_signed_distance)
   {
-    if (std::is_same<NarrowPhaseSolver, detail::GJKSolver_libccd<S>>::value
-        && object_type1 == OT_GEOM && object_type2 == OT_GEOM)
+    detail::computeSignedDistanceFromPenetration(
+          o1, tf1, o2, tf2, nsolver, request, result);
+  }
+
+  if(!nsolver_)
+    delete nsolver;
+
+  return res;
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S distanceBatch(
+    const std::vector<CollisionObjectPair<typename NarrowPhaseSolver::S>>& pairs,
+    const NarrowPhaseSolver* nsolver_,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    std::vector<DistanceResult<typename NarrowPhaseSolver::S>>& results,
+    ThreadPool* pool)
+{
+  using S = typename NarrowPhaseSolver::S;
+  using DistanceFunc
+      = typename detail::DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunc;
+
+  results.resize(pairs.size());
+  for(auto& result : results)
+    result.clear();
+
+  if(pairs.empty())
+    return std::numeric_limits<S>::max();
+
+  const NarrowPhaseSolver default_solver;
+  const NarrowPhaseSolver* nsolver = nsolver_ ? nsolver_ : &default_solver;
+
+  const std::size_t num_threads = pool ? pool->getNumThreads() : 1;
+  const std::size_t max_chunk_size = (num_threads == 1)
+      ? pairs.size()
+      : std::max<std::size_t>(1, pairs.size() / (4 * num_threads));
+
+  std::vector<std::size_t> order;
+  std::vector<detail::PairBatchChunk> chunks;
+  detail::groupPairsByNodeType(pairs, max_chunk_size, order, chunks);
+
+  // Resolve the distance function once per chunk. Chunks of the same key are
+  // adjacent, so each unsupported pair of node types is reported once.
+  const auto& looktable = getDistanceFunctionLookTable<NarrowPhaseSolver>();
+  std::vector<DistanceFunc> funcs(chunks.size(), nullptr);
+  std::vector<bool> swapped(chunks.size(), false);
+  for(std::size_t i = 0; i < chunks.size(); ++i)
+  {
+    const CollisionObjectPair<S>& pair = pairs[order[chunks[i].begin]];
+    const CollisionGeometry<S>* o1 = pair.first->collisionGeometry().get();
+    const CollisionGeometry<S>* o2 = pair.second->collisionGeometry().get();
+    NODE_TYPE node_type1 = o1->getNodeType();
+    NODE_TYPE node_type2 = o2->getNodeType();
+
+    if(o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_BVH)
     {
-      return res;
+      funcs[i] = looktable.distance_matrix[node_type2][node_type1];
+      swapped[i] = true;
+    }
+    else
+    {
+      funcs[i] = looktable.distance_matrix[node_type1][node_type2];
     }
 
-    CollisionRequest<S> collision_request;
-    collision_request.enable_contact = true;
-
-    CollisionResult<S> collision_result;
+    if(!funcs[i] && (i == 0 || chunks[i - 1].key != chunks[i].key))
+      std::cerr << "Warning: distance function between node type " << node_type1 << " and node type " << node_type2 << " is not supported" << std::endl;
+  }
 
-    collide(o1, tf1, o2, tf2, nsolver, collision_request, collision_result);
-    assert(collision_result.isCollision());
+  auto run_chunk = [&](std::size_t i, const NarrowPhaseSolver* solver)
+  {
+    const DistanceFunc func = funcs[i];
+    if(!func)
+      return;
 
-    std::size_t index = static_cast<std::size_t>(-1);
-    S max_pen_depth = std::numeric_limits<S>::min();
-    for (auto i = 0u; i < collision_result.numContacts(); ++i)
+    for(std::size_t j = chunks[i].begin; j < chunks[i].end; ++j)
     {
-      const auto& contact = collision_result.getContact(i);
-      if (max_pen_depth < contact.penetration_depth)
+      const std::size_t index = order[j];
+      const CollisionObject<S>* o1 = pairs[index].first;
+      const CollisionObject<S>* o2 = pairs[index].second;
+      if(swapped[i])
+        std::swap(o1, o2);
+
+      const CollisionGeometry<S>* g1 = o1->collisionGeometry().get();
+      const CollisionGeometry<S>* g2 = o2->collisionGeometry().get();
+      DistanceResult<S>& result = results[index];
+
+      S res = func(g1, o1->getTransform(), g2, o2->getTransform(),
+                   solver, request, result);
+
+      if(res
+         && result.min_distance < static_cast<S>(0)
+         && request.enable_signed_distance)
       {
-        max_pen_depth = contact.penetration_depth;
-        index = i;
+        detail::computeSignedDistanceFromPenetration(
+              g1, o1->getTransform(), g2, o2->getTransform(),
+              solver, request, result);
       }
     }
-    result.min_distance = -max_pen_depth;
-    assert(index != static_cast<std::size_t>(-1));
+  };
 
-    if (request.enable_nearest_points)
+  if(num_threads == 1)
+  {
+    for(std::size_t i = 0; i < chunks.size(); ++i)
+      run_chunk(i, nsolver);
+  }
+  else
+  {
+    // Solvers may keep mutable state (e.g., the cached guess of the
+    // independent GJK solver), so every thread works on its own copy.
+    std::vector<NarrowPhaseSolver> solvers(num_threads, *nsolver);
+    parallelFor(*pool, 0, chunks.size(), [&](std::size_t i)
     {
-      const Vector3<S>& pos = collision_result.getContact(index).pos;
-      result.nearest_points[0] = pos;
-      result.nearest_points[1] = pos;
-      // Note: The pair of nearest points is not guaranteed to be on the
-      // surface of the objects.
-    }
+      run_chunk(i, &solvers[pool->getThreadIndex()]);
+    });
   }
 
-  if(!nsolver_)
-    delete nsolver;
+  S min_distance = std::numeric_limits<S>::max();
+  for(const auto& result : results)
+    min_distance = std::min(min_distance, result.min_distance);
 
-  return res;
+  return min_distance;
 }
 
 //==============================================================================
@@ -245,6 +344,96 @@ S distance(
   }
 }
 
+//==============================================================================
+template <typename S>
+S distanceBatch(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    const DistanceRequest<S>& request,
+    std::vector<DistanceResult<S>>& results,
+    ThreadPool* pool)
+{
+  switch(request.gjk_solver_type)
+  {
+  case GST_LIBCCD:
+    {
+      detail::GJKSolver_libccd<S> solver;
+      solver.distance_tolerance = request.distance_tolerance;
+      return distanceBatch(pairs, &solver, request, results, pool);
+    }
+  case GST_INDEP:
+    {
+      detail::GJKSolver_indep<S> solver;
+      solver.gjk_tolerance = request.distance_tolerance;
+      return distanceBatch(pairs, &solver, request, results, pool);
+    }
+  default:
+    return -1;
+  }
+}
+
+namespace detail
+{
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+void computeSignedDistanceFromPenetration(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  // TODO(JS): FCL supports negative distance calculation only for OT_GEOM shape
+  // types (i.e., primitive shapes like sphere, cylinder, box, and so on). As a
+  // workaround for the rest shape types like mesh and octree, following
+  // computes negative distance using additional penetration depth computation
+  // of collision checking routine. The downside of this workaround is that the
+  // pair of nearest points is not guaranteed to be on the surface of the
+  // objects.
+  if (std::is_same<NarrowPhaseSolver, detail::GJKSolver_libccd<S>>::value
+      && o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_GEOM)
+  {
+    return;
+  }
+
+  CollisionRequest<S> collision_request;
+  collision_request.enable_contact = true;
+
+  CollisionResult<S> collision_result;
+
+  collide(o1, tf1, o2, tf2, nsolver, collision_request, collision_result);
+  assert(collision_result.isCollision());
+
+  std::size_t index = static_cast<std::size_t>(-1);
+  S max_pen_depth = std::numeric_limits<S>::min();
+  for (auto i = 0u; i < collision_result.numContacts(); ++i)
+  {
+    const auto& contact = collision_result.getContact(i);
+    if (max_pen_depth < contact.penetration_depth)
+    {
+      max_pen_depth = contact.penetration_depth;
+      index = i;
+    }
+  }
+  result.min_distance = -max_pen_depth;
+  assert(index != static_cast<std::size_t>(-1));
+
+  if (request.enable_nearest_points)
+  {
+    const Vector3<S>& pos = collision_result.getContact(index).pos;
+    result.nearest_points[0] = pos;
+    result.nearest_points[1] = pos;
+    // Note: The pair of nearest points is not guaranteed to be on the
+    // surface of the objects.
+  }
+}
+
+} // namespace detail
+
 } // namespace fcl
 
 #endif
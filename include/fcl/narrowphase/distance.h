@@ -38,6 +38,9 @@
 #ifndef FCL_DISTANCE_H
 #define FCL_DISTANCE_H
 
+#include <vector>
+
+#include "fcl/common/thread_pool.h"
 #include "fcl/narrowphase/collision_object.h"
 #include "fcl/narrowphase/detail/distance_func_matrix.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
@@ -61,6 +64,22 @@ S distance(
     const CollisionGeometry<S>* o2, const Transform3<S>& tf2,
     const DistanceRequest<S>& request, DistanceResult<S>& result);
 
+/// @brief Batched distance interface: computes the distance between the two
+/// objects of every pair with the same request, writing the outcome of
+/// pairs[i] to results[i] (results is resized to pairs.size() and every entry
+/// is cleared first). Pairs are grouped by the node types of their objects so
+/// the distance function is looked up once per group, and a single narrow
+/// phase solver is shared by the whole batch. If pool is given, the groups are
+/// split into chunks that run on its threads with one solver per thread.
+/// Return value is the minimum distance over all the pairs.
+template <typename S>
+FCL_EXPORT
+S distanceBatch(
+    const std::vector<CollisionObjectPair<S>>& pairs,
+    const DistanceRequest<S>& request,
+    std::vector<DistanceResult<S>>& results,
+    ThreadPool* pool = nullptr);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/distance-inl.h"
@@ -39,6 +39,7 @@
 #define FCL_DISTANCEREQUEST_H
 
 #include "fcl/common/types.h"
+#include "fcl/narrowphase/gjk_cache.h"
 #include "fcl/narrowphase/gjk_solver_type.h"
 
 namespace fcl
@@ -101,6 +102,10 @@ struct FCL_EXPORT DistanceRequest
   /// @brief narrow phase solver type
   GJKSolverType gjk_solver_type;
 
+  /// @brief if not null, shape-shape queries warm start GJK from the state
+  /// their pair of geometries ended with in the previous query, and update it
+  GJKCache<S>* gjk_cache;
+
   explicit DistanceRequest(
       bool enable_nearest_points_ = false,
       bool enable_signed_distance = false,
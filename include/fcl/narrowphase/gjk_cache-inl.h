@@ -0,0 +1,108 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_GJKCACHE_INL_H
+#define FCL_NARROWPHASE_GJKCACHE_INL_H
+
+#include "fcl/narrowphase/gjk_cache.h"
+
+#include <functional>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+struct GJKWarmStart<double>;
+
+//==============================================================================
+extern template
+class GJKCache<double>;
+
+//==============================================================================
+template <typename S>
+GJKWarmStart<S>::GJKWarmStart()
+  : rank(0), axis(Vector3<S>::UnitX())
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+GJKWarmStart<S>& GJKCache<S>::get(
+    const CollisionGeometry<S>* o1, const CollisionGeometry<S>* o2)
+{
+  return warm_starts[Key(o1, o2)];
+}
+
+//==============================================================================
+template <typename S>
+void GJKCache<S>::invalidate(const CollisionGeometry<S>* o)
+{
+  for(auto it = warm_starts.begin(); it != warm_starts.end();)
+  {
+    if(it->first.first == o || it->first.second == o)
+      it = warm_starts.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+template <typename S>
+void GJKCache<S>::clear()
+{
+  warm_starts.clear();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t GJKCache<S>::size() const
+{
+  return warm_starts.size();
+}
+
+//==============================================================================
+template <typename S>
+std::size_t GJKCache<S>::KeyHash::operator()(const Key& key) const
+{
+  std::hash<const void*> hash;
+  std::size_t seed = hash(key.first);
+  seed ^= hash(key.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+} // namespace fcl
+
+#endif
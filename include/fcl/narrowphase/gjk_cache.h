@@ -0,0 +1,116 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_GJKCACHE_H
+#define FCL_NARROWPHASE_GJKCACHE_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+#include "fcl/common/types.h"
+
+namespace fcl
+{
+
+template <typename S>
+class CollisionGeometry;
+
+/// @brief Final state of GJK for a pair of shapes, from which the next query
+/// between them starts
+template <typename S>
+struct FCL_EXPORT GJKWarmStart
+{
+  /// @brief support directions of the vertices of the final simplex, in the
+  /// frame of the first shape
+  Vector3<S> directions[4];
+
+  /// @brief number of vertices of the final simplex, 0 if there is none yet
+  std::size_t rank;
+
+  /// @brief final separating axis (the point of the Minkowski difference
+  /// closest to the origin)
+  Vector3<S> axis;
+
+  GJKWarmStart();
+};
+
+/// @brief Persistent warm starts of GJK for pairs of geometries. When passed
+/// in CollisionRequest::gjk_cache or DistanceRequest::gjk_cache, each
+/// shape-shape query starts GJK from the simplex its pair ended with in the
+/// previous query, so that for poses that barely changed GJK ends in one or two
+/// iterations. A warm start only seeds GJK, so a stale one slows a query down
+/// but does not change its result. Not thread-safe: give each thread its own
+/// cache when running queries in parallel.
+///
+/// Only used by the GST_INDEP solver.
+template <typename S>
+class FCL_EXPORT GJKCache
+{
+public:
+  /// @brief The warm start of the queries between o1 and o2 in this order,
+  /// which is empty (rank 0) before the first one
+  GJKWarmStart<S>& get(const CollisionGeometry<S>* o1,
+                       const CollisionGeometry<S>* o2);
+
+  /// @brief Remove the warm starts of all the pairs with o, e.g. after its
+  /// geometry was changed in place or before it is deleted
+  void invalidate(const CollisionGeometry<S>* o);
+
+  /// @brief Remove all the warm starts
+  void clear();
+
+  /// @brief The number of pairs that have a warm start
+  std::size_t size() const;
+
+private:
+  using Key = std::pair<const CollisionGeometry<S>*,
+                        const CollisionGeometry<S>*>;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  std::unordered_map<Key, GJKWarmStart<S>, KeyHash> warm_starts;
+};
+
+using GJKCachef = GJKCache<float>;
+using GJKCached = GJKCache<double>;
+
+} // namespace fcl
+
+#include "fcl/narrowphase/gjk_cache-inl.h"
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/broadphase/detail/pair_hash_set.h"
+
+#include <algorithm>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+PairHashSet::PairHashSet()
+  : shift_(64)
+{
+  rehash(16);
+}
+
+//==============================================================================
+bool PairHashSet::insert(uint32 a, uint32 b)
+{
+  const Pair pair = makePair(a, b);
+  std::size_t slot = findSlot(pair);
+  if(slots_[slot])
+    return false;
+
+  // keep the load factor at most 1/2
+  if(2 * (pairs_.size() + 1) > slots_.size())
+  {
+    rehash(2 * slots_.size());
+    slot = findSlot(pair);
+  }
+
+  pairs_.push_back(pair);
+  slots_[slot] = static_cast<uint32>(pairs_.size());
+  return true;
+}
+
+//==============================================================================
+bool PairHashSet::erase(uint32 a, uint32 b)
+{
+  const std::size_t slot = findSlot(makePair(a, b));
+  if(!slots_[slot])
+    return false;
+
+  eraseSlot(slot);
+  return true;
+}
+
+//==============================================================================
+void PairHashSet::eraseAll(uint32 a)
+{
+  std::size_t i = 0;
+  while(i < pairs_.size())
+  {
+    if(pairs_[i].first == a || pairs_[i].second == a)
+      eraseSlot(findSlot(pairs_[i])); // moves the last pair to i
+    else
+      ++i;
+  }
+}
+
+//==============================================================================
+bool PairHashSet::contains(uint32 a, uint32 b) const
+{
+  return slots_[findSlot(makePair(a, b))] != 0;
+}
+
+//==============================================================================
+void PairHashSet::clear()
+{
+  pairs_.clear();
+  std::fill(slots_.begin(), slots_.end(), 0);
+}
+
+//==============================================================================
+std::size_t PairHashSet::size() const
+{
+  return pairs_.size();
+}
+
+//==============================================================================
+const std::vector<PairHashSet::Pair>& PairHashSet::getPairs() const
+{
+  return pairs_;
+}
+
+//==============================================================================
+PairHashSet::Pair PairHashSet::makePair(uint32 a, uint32 b)
+{
+  return (a < b) ? Pair(a, b) : Pair(b, a);
+}
+
+//==============================================================================
+std::size_t PairHashSet::findSlot(const Pair& pair) const
+{
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t slot = getHomeSlot(pair);
+  while(slots_[slot] && pairs_[slots_[slot] - 1] != pair)
+    slot = (slot + 1) & mask;
+
+  return slot;
+}
+
+//==============================================================================
+std::size_t PairHashSet::getHomeSlot(const Pair& pair) const
+{
+  // Fibonacci hashing: the high bits of the product mix all the key bits
+  const uint64 key = (static_cast<uint64>(pair.first) << 32) | pair.second;
+  return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+}
+
+//==============================================================================
+void PairHashSet::eraseSlot(std::size_t slot)
+{
+  const std::size_t mask = slots_.size() - 1;
+
+  // move the last pair into the place of the erased one
+  const uint32 index = slots_[slot] - 1;
+  if(index + 1 != pairs_.size())
+  {
+    slots_[findSlot(pairs_.back())] = index + 1;
+    pairs_[index] = pairs_.back();
+  }
+  pairs_.pop_back();
+
+  // backward-shift the entries after the hole that may not be skipped over
+  std::size_t hole = slot;
+  std::size_t next = slot;
+  while(true)
+  {
+    next = (next + 1) & mask;
+    if(!slots_[next])
+      break;
+
+    const std::size_t home = getHomeSlot(pairs_[slots_[next] - 1]);
+    // the entry stays if its home is cyclically in (hole, next]
+    const bool stays = (hole <= next) ? (hole < home && home <= next)
+                                      : (hole < home || home <= next);
+    if(!stays)
+    {
+      slots_[hole] = slots_[next];
+      hole = next;
+    }
+  }
+  slots_[hole] = 0;
+}
+
+//==============================================================================
+void PairHashSet::rehash(std::size_t num_slots)
+{
+  shift_ = 64;
+  for(std::size_t n = num_slots; n > 1; n >>= 1)
+    --shift_;
+
+  slots_.assign(num_slots, 0);
+  for(std::size_t i = 0; i < pairs_.size(); ++i)
+    slots_[findSlot(pairs_[i])] = static_cast<uint32>(i + 1);
+}
+
+} // namespace detail
+} // namespace fcl
@@ -0,0 +1,131 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/common/detail/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+Arena::Scope::Scope(Arena& arena)
+  : arena_(arena), block_(arena.block_), offset_(arena.offset_)
+{
+  // Do nothing
+}
+
+//==============================================================================
+Arena::Scope::~Scope()
+{
+  arena_.block_ = block_;
+  arena_.offset_ = offset_;
+}
+
+//==============================================================================
+Arena::Arena(std::size_t block_size)
+  : block_size_(block_size), block_(0), offset_(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+  while(true)
+  {
+    if(block_ == blocks_.size())
+    {
+      Block block;
+      block.size = std::max(block_size_, size + alignment);
+      block.data.reset(new char[block.size]);
+      blocks_.push_back(std::move(block));
+    }
+
+    const Block& block = blocks_[block_];
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(block.data.get());
+    const std::uintptr_t aligned
+        = (begin + offset_ + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    const std::size_t end = static_cast<std::size_t>(aligned - begin) + size;
+    if(end <= block.size)
+    {
+      offset_ = end;
+      return reinterpret_cast<void*>(aligned);
+    }
+
+    ++block_;
+    offset_ = 0;
+  }
+}
+
+//==============================================================================
+void Arena::reset()
+{
+  block_ = 0;
+  offset_ = 0;
+}
+
+//==============================================================================
+std::size_t Arena::getUsed() const
+{
+  std::size_t used = offset_;
+  for(std::size_t i = 0; i < block_ && i < blocks_.size(); ++i)
+    used += blocks_[i].size;
+
+  return used;
+}
+
+//==============================================================================
+std::size_t Arena::getCapacity() const
+{
+  std::size_t capacity = 0;
+  for(const Block& block : blocks_)
+    capacity += block.size;
+
+  return capacity;
+}
+
+//==============================================================================
+Arena& Arena::threadLocal()
+{
+  thread_local Arena arena;
+  return arena;
+}
+
+} // namespace detail
+} // namespace fcl
@@ -0,0 +1,270 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2017, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/common/thread_pool.h"
+
+namespace fcl
+{
+
+namespace
+{
+
+/// @brief The pool the current thread works for, if any, and its index there
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+} // namespace
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t num_threads)
+  : num_queued_(0), stop_(false)
+{
+  if(num_threads == 0)
+    num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  const std::size_t num_workers = num_threads - 1;
+
+  queues_.reserve(num_workers + 1);
+  for(std::size_t i = 0; i < num_workers + 1; ++i)
+    queues_.emplace_back(new Queue);
+
+  threads_.reserve(num_workers);
+  for(std::size_t i = 0; i < num_workers; ++i)
+    threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+
+  for(auto& thread : threads_)
+    thread.join();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return threads_.size() + 1;
+}
+
+//==============================================================================
+std::size_t ThreadPool::getThreadIndex() const
+{
+  if(current_pool == this)
+    return current_index;
+  else
+    return threads_.size();
+}
+
+//==============================================================================
+void ThreadPool::submit(Job job)
+{
+  Queue& queue = *queues_[getThreadIndex()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    ++num_queued_;
+  }
+  wake_.notify_one();
+}
+
+//==============================================================================
+bool ThreadPool::tryPop(std::size_t index, Job& job)
+{
+  if(num_queued_ == 0)
+    return false;
+
+  // Own work first, newest task first
+  {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(!queue.jobs.empty())
+    {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      --num_queued_;
+      return true;
+    }
+  }
+
+  // Steal the oldest task of another thread, which tends to be the largest
+  for(std::size_t i = 1; i < queues_.size(); ++i)
+  {
+    Queue& queue = *queues_[(index + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(!queue.jobs.empty())
+    {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+      --num_queued_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void ThreadPool::execute(Job& job)
+{
+  TaskGroup* group = job.group;
+
+  try
+  {
+    job.function();
+  }
+  catch(...)
+  {
+    std::lock_guard<std::mutex> lock(group->exception_mutex_);
+    if(!group->exception_)
+      group->exception_ = std::current_exception();
+  }
+
+  // Release the captured state before the group may go out of scope
+  job.function = nullptr;
+
+  if(--group->pending_ == 0)
+  {
+    // The group may be destroyed as soon as its waiter sees pending_ == 0, so
+    // only the pool is touched from here. Taking the lock orders this
+    // notification after the waiter checked its predicate.
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_.notify_all();
+  }
+}
+
+//==============================================================================
+void ThreadPool::workerLoop(std::size_t index)
+{
+  current_pool = this;
+  current_index = index;
+
+  Job job;
+  while(true)
+  {
+    if(tryPop(index, job))
+    {
+      execute(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.wait(lock, [this]() { return stop_ || num_queued_ > 0; });
+    if(stop_)
+      return;
+  }
+}
+
+//==============================================================================
+TaskGroup::TaskGroup(ThreadPool& pool)
+  : pool_(pool), pending_(0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+TaskGroup::~TaskGroup()
+{
+  try
+  {
+    wait();
+  }
+  catch(...)
+  {
+    // Exceptions are only reported through an explicit call to wait()
+  }
+}
+
+//==============================================================================
+void TaskGroup::run(std::function<void()> task)
+{
+  ++pending_;
+
+  ThreadPool::Job job;
+  job.function = std::move(task);
+  job.group = this;
+  pool_.submit(std::move(job));
+}
+
+//==============================================================================
+void TaskGroup::wait()
+{
+  const std::size_t index = pool_.getThreadIndex();
+
+  ThreadPool::Job job;
+  while(pending_ > 0)
+  {
+    if(pool_.tryPop(index, job))
+    {
+      pool_.execute(job);
+      continue;
+    }
+
+    // Nothing left to help with: sleep until the last task of the group
+    // finished or new tasks, possibly spawned by ours, were queued
+    std::unique_lock<std::mutex> lock(pool_.wake_mutex_);
+    pool_.wake_.wait(lock, [this]()
+    {
+      return pending_ == 0 || pool_.num_queued_ > 0;
+    });
+  }
+
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(exception_mutex_);
+    std::swap(exception, exception_);
+  }
+
+  if(exception)
+    std::rethrow_exception(exception);
+}
+
+//==============================================================================
+ThreadPool& TaskGroup::getPool() const
+{
+  return pool_;
+}
+
+} // namespace fcl
@@ -196,5 +196,21 @@ class ConvertBVImpl<double, OBBRSS<double>, RSS<double>>;
 template
 class ConvertBVImpl<double, AABB<double>, RSS<double>>;
 
+//==============================================================================
+template
+class BoundingOBBImpl<double, AABB<double>>;
+
+//==============================================================================
+template
+class BoundingOBBImpl<double, OBB<double>>;
+
+//==============================================================================
+template
+class BoundingOBBImpl<double, RSS<double>>;
+
+//==============================================================================
+template
+class BoundingOBBImpl<double, OBBRSS<double>>;
+
 } // namespace detail
 } // namespace fcl
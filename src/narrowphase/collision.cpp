@@ -58,4 +58,12 @@ std::size_t collide(
     const CollisionRequest<double>& request,
     CollisionResult<double>& result);
 
+//==============================================================================
+template
+std::size_t collideBatch(
+    const std::vector<CollisionObjectPair<double>>& pairs,
+    const CollisionRequest<double>& request,
+    std::vector<CollisionResult<double>>& results,
+    ThreadPool* pool);
+
 } // namespace fcl
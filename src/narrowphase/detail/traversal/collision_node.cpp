@@ -47,6 +47,18 @@ namespace detail
 template
 void collide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
 
+//==============================================================================
+template
+void collide(MeshCollisionTraversalNodeOBB<double>* node, BVHFrontList* front_list);
+
+//==============================================================================
+template
+void collide(MeshCollisionTraversalNodeRSS<double>* node, BVHFrontList* front_list);
+
+//==============================================================================
+template
+void collide(MeshCollisionTraversalNodeOBBRSS<double>* node, BVHFrontList* front_list);
+
 //==============================================================================
 template
 void selfCollide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
@@ -55,6 +67,14 @@ void selfCollide(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_l
 template
 void distance(DistanceTraversalNodeBase<double>* node, BVHFrontList* front_list, int qsize);
 
+//==============================================================================
+template
+void distance(MeshDistanceTraversalNodeRSS<double>* node, BVHFrontList* front_list, int qsize);
+
+//==============================================================================
+template
+void distance(MeshDistanceTraversalNodeOBBRSS<double>* node, BVHFrontList* front_list, int qsize);
+
 //==============================================================================
 template
 void collide2(MeshCollisionTraversalNodeOBB<double>* node, BVHFrontList* front_list);
@@ -55,6 +55,54 @@ void collisionRecurse(MeshCollisionTraversalNodeOBB<double>* node, int b1, int b
 template
 void collisionRecurse(MeshCollisionTraversalNodeRSS<double>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T, BVHFrontList* front_list);
 
+//==============================================================================
+template
+void collisionRecursePacket(MeshCollisionTraversalNode<OBB<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecursePacket(MeshCollisionTraversalNode<RSS<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecursePacket(MeshCollisionTraversalNode<OBBRSS<double>>* node, int b1, int b2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBB<double>>* node, const WideBVH<OBB<double>, 4>& wide1, const WideBVH<OBB<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBB<double>>* node, const WideBVH<OBB<double>, 8>& wide1, const WideBVH<OBB<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 4>& wide1, const WideBVH<RSS<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 8>& wide1, const WideBVH<RSS<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 4>& wide1, const WideBVH<OBBRSS<double>, 4>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void collisionRecurseWide(MeshCollisionTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 8>& wide1, const WideBVH<OBBRSS<double>, 8>& wide2, int b1, int w1, int b2, int w2, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<OBB<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<RSS<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
+//==============================================================================
+template
+void orientedCollisionRecurse(MeshCollisionTraversalNode<OBBRSS<double>>* node, const Matrix3<double>& R, const Vector3<double>& T);
+
 //==============================================================================
 template
 void selfCollisionRecurse(CollisionTraversalNodeBase<double>* node, int b, BVHFrontList* front_list);
@@ -67,6 +115,30 @@ void distanceRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b2, BV
 template
 void distanceQueueRecurse(DistanceTraversalNodeBase<double>* node, int b1, int b2, BVHFrontList* front_list, int qsize);
 
+//==============================================================================
+template
+void distanceRecurseWide(MeshDistanceTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 4>& wide1, const WideBVH<RSS<double>, 4>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+template
+void distanceRecurseWide(MeshDistanceTraversalNode<RSS<double>>* node, const WideBVH<RSS<double>, 8>& wide1, const WideBVH<RSS<double>, 8>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+template
+void distanceRecurseWide(MeshDistanceTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 4>& wide1, const WideBVH<OBBRSS<double>, 4>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+template
+void distanceRecurseWide(MeshDistanceTraversalNode<OBBRSS<double>>* node, const WideBVH<OBBRSS<double>, 8>& wide1, const WideBVH<OBBRSS<double>, 8>& wide2, int b1, int w1, int b2, int w2);
+
+//==============================================================================
+template
+void orientedDistanceRecurse(MeshDistanceTraversalNode<RSS<double>>* node);
+
+//==============================================================================
+template
+void orientedDistanceRecurse(MeshDistanceTraversalNode<OBBRSS<double>>* node);
+
 //==============================================================================
 template
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase<double>* node, BVHFrontList* front_list);
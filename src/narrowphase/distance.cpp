@@ -55,4 +55,12 @@ double distance(
     const CollisionGeometry<double>* o2, const Transform3<double>& tf2,
     const DistanceRequest<double>& request, DistanceResult<double>& result);
 
+//==============================================================================
+template
+double distanceBatch(
+    const std::vector<CollisionObjectPair<double>>& pairs,
+    const DistanceRequest<double>& request,
+    std::vector<DistanceResult<double>>& results,
+    ThreadPool* pool);
+
 } // namespace fcl
@@ -41,10 +41,12 @@
 #include "fcl/broadphase/broadphase_bruteforce.h"
 #include "fcl/broadphase/broadphase_spatialhash.h"
 #include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_batch_SaP.h"
 #include "fcl/broadphase/broadphase_SSaP.h"
 #include "fcl/broadphase/broadphase_interval_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree_array.h"
+#include "fcl/broadphase/detail/pair_hash_set.h"
 #include "fcl/broadphase/detail/sparse_hash_table.h"
 #include "fcl/broadphase/detail/spatial_hash.h"
 #include "fcl/geometry/geometric_shape_to_BVH_model.h"
@@ -66,6 +68,21 @@ using namespace fcl;
 template <typename S>
 void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool verbose = false);
 
+/// @brief make sure the parallel self collision of the dynamic AABB tree
+/// reports the same pairs as the serial one
+template <typename S>
+void broad_phase_parallel_self_collision_test(S env_scale, std::size_t env_size, std::size_t num_threads);
+
+/// @brief make sure the overlapping pairs kept by SaP through registrations,
+/// removals and moves are the overlapping pairs of the AABBs
+template <typename S>
+void broad_phase_SaP_incremental_pairs_test(std::size_t env_size, std::size_t num_frames);
+
+/// @brief make sure the parallel sweep of the batch SaP finds the overlapping
+/// pairs of the AABBs in the same order as the serial one
+template <typename S>
+void broad_phase_batch_SaP_test(std::size_t env_size, std::size_t num_threads);
+
 /// @brief test for broad phase update
 template <typename S>
 void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts = 1, bool exhaustive = false, bool use_mesh = false);
@@ -95,6 +112,88 @@ GTEST_TEST(FCL_BROADPHASE, test_broad_phase_dont_duplicate_check)
 #endif
 }
 
+/// check the parallel self collision against the serial one
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_parallel_self_collision)
+{
+#ifdef NDEBUG
+  broad_phase_parallel_self_collision_test<double>(2000, 1000, 4);
+  broad_phase_parallel_self_collision_test<double>(2000, 1000, 1);
+#else
+  broad_phase_parallel_self_collision_test<double>(2000, 100, 4);
+  broad_phase_parallel_self_collision_test<double>(2000, 100, 1);
+#endif
+}
+
+/// check the pair set against brute force enumeration
+GTEST_TEST(FCL_BROADPHASE, test_pair_hash_set)
+{
+  detail::PairHashSet pairs;
+  std::set<std::pair<uint32, uint32>> expected;
+
+  std::srand(1);
+  for(int i = 0; i < 20000; ++i)
+  {
+    uint32 a = std::rand() % 100;
+    uint32 b = std::rand() % 100;
+    if(a == b)
+      continue;
+    const std::pair<uint32, uint32> pair(std::min(a, b), std::max(a, b));
+
+    switch(std::rand() % 8)
+    {
+    case 0:
+      EXPECT_EQ(pairs.erase(a, b), expected.erase(pair) == 1);
+      break;
+    case 1:
+      pairs.eraseAll(a);
+      for(auto it = expected.begin(); it != expected.end();)
+      {
+        if(it->first == a || it->second == a)
+          it = expected.erase(it);
+        else
+          ++it;
+      }
+      break;
+    default:
+      EXPECT_EQ(pairs.insert(b, a), expected.insert(pair).second);
+    }
+
+    EXPECT_TRUE(pairs.contains(a, b) == (expected.count(pair) == 1));
+    EXPECT_EQ(pairs.size(), expected.size());
+  }
+
+  std::set<std::pair<uint32, uint32>> stored(
+        pairs.getPairs().begin(), pairs.getPairs().end());
+  EXPECT_TRUE(stored == expected);
+
+  pairs.clear();
+  EXPECT_EQ(pairs.size(), 0u);
+  EXPECT_TRUE(pairs.getPairs().empty());
+}
+
+/// check the incremental SaP update against brute force enumeration
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_SaP_incremental_pairs)
+{
+#ifdef NDEBUG
+  broad_phase_SaP_incremental_pairs_test<double>(2000, 20);
+#else
+  broad_phase_SaP_incremental_pairs_test<double>(300, 10);
+#endif
+}
+
+/// check the batch SaP pairs against brute force enumeration
+GTEST_TEST(FCL_BROADPHASE, test_broad_phase_batch_SaP)
+{
+#ifdef NDEBUG
+  broad_phase_batch_SaP_test<double>(20000, 4);
+  broad_phase_batch_SaP_test<float>(20000, 4);
+#else
+  broad_phase_batch_SaP_test<double>(1000, 4);
+  broad_phase_batch_SaP_test<float>(1000, 4);
+#endif
+  broad_phase_batch_SaP_test<double>(3, 4);
+}
+
 /// check the update, only return collision or not
 GTEST_TEST(FCL_BROADPHASE, test_core_bf_broad_phase_update_collision_binary)
 {
@@ -213,6 +312,13 @@ void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool ve
   managers.push_back(new SSaPCollisionManager<S>());
   managers.push_back(new SaPCollisionManager<S>());
   managers.push_back(new IntervalTreeCollisionManager<S>());
+  managers.push_back(new BatchSaPCollisionManager<S>());
+
+  {
+    BatchSaPCollisionManager<S>* m = new BatchSaPCollisionManager<S>();
+    m->sweep_pool = std::make_shared<ThreadPool>(4);
+    managers.push_back(m);
+  }
   Vector3<S> lower_limit, upper_limit;
   SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
   S cell_size = std::min(std::min((upper_limit[0] - lower_limit[0]) / 20, (upper_limit[1] - lower_limit[1]) / 20), (upper_limit[2] - lower_limit[2])/20);
@@ -345,6 +451,294 @@ void broad_phase_duplicate_check_test(S env_scale, std::size_t env_size, bool ve
   std::cout << std::endl;
 }
 
+//==============================================================================
+template <typename S>
+bool collisionFunctionForPairCollecting(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* pairs = static_cast<
+      std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>>*>(cdata_);
+
+  pairs->emplace_back(o1, o2);
+
+  return false;
+}
+
+//==============================================================================
+template <typename S>
+struct LimitedPairCollectingData
+{
+  std::vector<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  std::size_t max_pairs;
+};
+
+//==============================================================================
+template <typename S>
+bool collisionFunctionForLimitedPairCollecting(
+    CollisionObject<S>* o1, CollisionObject<S>* o2, void* cdata_)
+{
+  auto* cdata = static_cast<LimitedPairCollectingData<S>*>(cdata_);
+
+  cdata->pairs.emplace_back(o1, o2);
+
+  return cdata->pairs.size() >= cdata->max_pairs;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_parallel_self_collision_test(S env_scale, std::size_t env_size, std::size_t num_threads)
+{
+  using ObjectPair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::vector<CollisionObject<S>*> env;
+  test::generateEnvironments(env, env_scale, env_size);
+
+  DynamicAABBTreeCollisionManager<S> manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  std::vector<ObjectPair> serial_pairs;
+  manager.collide(&serial_pairs, collisionFunctionForPairCollecting<S>);
+
+  ThreadPool pool(num_threads);
+  EXPECT_EQ(pool.getNumThreads(), num_threads);
+
+  // Merged on the calling thread: same pairs in the same order
+  std::vector<ObjectPair> merged_pairs;
+  manager.collide(&merged_pairs, collisionFunctionForPairCollecting<S>, pool);
+  EXPECT_TRUE(merged_pairs == serial_pairs);
+
+  // Stopping early delivers exactly the first pairs of the serial order
+  LimitedPairCollectingData<S> limited;
+  limited.max_pairs = serial_pairs.size() / 2 + 1;
+  manager.collide(&limited, collisionFunctionForLimitedPairCollecting<S>, pool);
+  GTEST_ASSERT_EQ(limited.pairs.size(), std::min(limited.max_pairs, serial_pairs.size()));
+  EXPECT_TRUE(std::equal(limited.pairs.begin(), limited.pairs.end(), serial_pairs.begin()));
+
+  // Per-thread buffers: same pairs once sorted
+  std::vector<std::vector<ObjectPair>> thread_pairs(pool.getNumThreads());
+  std::vector<void*> thread_cdata;
+  for(auto& pairs : thread_pairs)
+    thread_cdata.push_back(&pairs);
+
+  // A cdata vector of the wrong size is rejected
+  std::vector<void*> short_cdata(thread_cdata.begin(), thread_cdata.end() - 1);
+  manager.collide(short_cdata, collisionFunctionForPairCollecting<S>, pool);
+  for(const auto& pairs : thread_pairs)
+    EXPECT_TRUE(pairs.empty());
+
+  manager.collide(thread_cdata, collisionFunctionForPairCollecting<S>, pool);
+
+  std::vector<ObjectPair> concurrent_pairs;
+  for(const auto& pairs : thread_pairs)
+    concurrent_pairs.insert(concurrent_pairs.end(), pairs.begin(), pairs.end());
+
+  std::sort(serial_pairs.begin(), serial_pairs.end());
+  std::sort(concurrent_pairs.begin(), concurrent_pairs.end());
+  EXPECT_TRUE(concurrent_pairs == serial_pairs);
+
+  for (auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>>
+getOverlappingPairs(const std::vector<CollisionObject<S>*>& objs)
+{
+  std::set<std::pair<CollisionObject<S>*, CollisionObject<S>*>> pairs;
+  for(std::size_t i = 0; i < objs.size(); ++i)
+  {
+    for(std::size_t j = i + 1; j < objs.size(); ++j)
+    {
+      if(objs[i]->getAABB().overlap(objs[j]->getAABB()))
+        pairs.emplace(std::min(objs[i], objs[j]), std::max(objs[i], objs[j]));
+    }
+  }
+
+  return pairs;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_batch_SaP_test(std::size_t env_size, std::size_t num_threads)
+{
+  using ObjectPair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::srand(1);
+  auto random = [](S lo, S hi) { return lo + (hi - lo) * std::rand() / RAND_MAX; };
+
+  // unit boxes around the origin, so that bounds are negative, positive and
+  // zero; every tenth one is in a row of touching boxes
+  auto box = std::make_shared<Box<S>>(1, 1, 1);
+  const S extent = std::pow(static_cast<S>(env_size), 1.0 / 3.0);
+  std::vector<CollisionObject<S>*> env;
+  for(std::size_t i = 0; i < env_size; ++i)
+  {
+    Transform3<S> tf = Transform3<S>::Identity();
+    if(i % 10 == 0)
+      tf.translation() = Vector3<S>(0, static_cast<S>(i / 10) - 0.5, 0.5);
+    else
+      tf.translation() = Vector3<S>(random(-extent, extent),
+                                    random(-extent, extent),
+                                    random(-extent, extent));
+    env.push_back(new CollisionObject<S>(box, tf));
+  }
+
+  BatchSaPCollisionManager<S> serial;
+  serial.registerObjects(env);
+  serial.setup();
+
+  BatchSaPCollisionManager<S> parallel;
+  parallel.sweep_pool = std::make_shared<ThreadPool>(num_threads);
+  parallel.sweep_chunks_per_thread = 3;
+  for(auto obj : env)
+    parallel.registerObject(obj);
+  parallel.setup();
+
+  std::vector<ObjectPair> serial_pairs;
+  serial.collide(&serial_pairs, collisionFunctionForPairCollecting<S>);
+
+  std::vector<ObjectPair> parallel_pairs;
+  parallel.collide(&parallel_pairs, collisionFunctionForPairCollecting<S>);
+  EXPECT_TRUE(parallel_pairs == serial_pairs);
+
+  std::set<ObjectPair> found;
+  for(const auto& pair : serial_pairs)
+    found.emplace(std::min(pair.first, pair.second),
+                  std::max(pair.first, pair.second));
+  EXPECT_EQ(found.size(), serial_pairs.size());
+  EXPECT_TRUE(found == getOverlappingPairs(env));
+
+  // the pairs follow the objects after update()
+  for(auto obj : env)
+  {
+    obj->setTranslation(obj->getTranslation() * 0.5);
+    obj->computeAABB();
+  }
+  CollisionObject<S>* removed = env.back();
+  parallel.unregisterObject(removed);
+  parallel.update();
+  env.pop_back();
+  delete removed;
+
+  parallel_pairs.clear();
+  parallel.collide(&parallel_pairs, collisionFunctionForPairCollecting<S>);
+  found.clear();
+  for(const auto& pair : parallel_pairs)
+    found.emplace(std::min(pair.first, pair.second),
+                  std::max(pair.first, pair.second));
+  EXPECT_EQ(found.size(), parallel_pairs.size());
+  EXPECT_TRUE(found == getOverlappingPairs(env));
+
+  for(auto obj : env)
+    delete obj;
+}
+
+//==============================================================================
+template <typename S>
+void broad_phase_SaP_incremental_pairs_test(std::size_t env_size, std::size_t num_frames)
+{
+  using ObjectPair = std::pair<CollisionObject<S>*, CollisionObject<S>*>;
+
+  std::srand(1);
+  auto random = [](S lo, S hi) { return lo + (hi - lo) * std::rand() / RAND_MAX; };
+
+  // boxes of a few sizes; every tenth one is in a row of touching unit boxes
+  std::vector<std::shared_ptr<Box<S>>> boxes;
+  boxes.push_back(std::make_shared<Box<S>>(1, 1, 1));
+  boxes.push_back(std::make_shared<Box<S>>(2, 0.5, 1));
+  boxes.push_back(std::make_shared<Box<S>>(8, 8, 8));
+
+  const S extent = std::pow(static_cast<S>(env_size), 1.0 / 3.0) * 2;
+  std::vector<CollisionObject<S>*> env;
+  for(std::size_t i = 0; i < env_size; ++i)
+  {
+    Transform3<S> tf = Transform3<S>::Identity();
+    if(i % 10 == 0)
+      tf.translation() = Vector3<S>(static_cast<S>(i / 10), 0, 0);
+    else
+      tf.translation() = Vector3<S>(random(-extent, extent),
+                                    random(-extent, extent),
+                                    random(-extent, extent));
+    env.push_back(new CollisionObject<S>(
+                    boxes[(i % 10 == 0) ? 0 : i % boxes.size()], tf));
+  }
+
+  SaPCollisionManager<S> manager;
+  std::vector<CollisionObject<S>*> bulk(env.begin(), env.begin() + env_size / 2);
+  manager.registerObjects(bulk);
+  for(std::size_t i = env_size / 2; i < env_size; ++i)
+    manager.registerObject(env[i]);
+  manager.setup();
+  EXPECT_FALSE(manager.empty());
+
+  std::vector<CollisionObject<S>*> registered(env);
+  for(std::size_t frame = 0; frame <= num_frames; ++frame)
+  {
+    std::vector<ObjectPair> pairs;
+    manager.collide(&pairs, collisionFunctionForPairCollecting<S>);
+
+    std::set<ObjectPair> found;
+    for(const auto& pair : pairs)
+      found.emplace(std::min(pair.first, pair.second),
+                    std::max(pair.first, pair.second));
+    EXPECT_EQ(found.size(), pairs.size());
+    EXPECT_TRUE(found == getOverlappingPairs(registered));
+    EXPECT_EQ(manager.size(), registered.size());
+
+    // move some of the objects a little, and a few of them far away; SaP
+    // moves the intervals one by one when few of them change
+    for(auto obj : registered)
+    {
+      if(std::rand() % ((frame % 2) ? 2 : 16) != 0)
+        continue;
+
+      const S step = (std::rand() % 50 == 0) ? extent : 0.5;
+      Vector3<S> t = obj->getTranslation();
+      for(int k = 0; k < 3; ++k)
+        t[k] += random(-step, step);
+      obj->setTranslation(t);
+      obj->computeAABB();
+    }
+
+    // swap some objects out and back in
+    if(frame % 3 == 1)
+    {
+      for(std::size_t i = 0; i < registered.size(); i += 7)
+      {
+        manager.unregisterObject(registered[i]);
+        registered[i] = nullptr;
+      }
+      registered.erase(
+            std::remove(registered.begin(), registered.end(), nullptr),
+            registered.end());
+    }
+    else if(frame % 3 == 2)
+    {
+      for(auto obj : env)
+      {
+        if(std::find(registered.begin(), registered.end(), obj) == registered.end())
+        {
+          manager.registerObject(obj);
+          registered.push_back(obj);
+        }
+      }
+    }
+
+    if(frame % 2)
+      manager.update();
+    else
+      manager.update(registered);
+  }
+
+  manager.clear();
+  EXPECT_TRUE(manager.empty());
+
+  for(auto obj : env)
+    delete obj;
+}
+
 template <typename S>
 void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::size_t query_size, std::size_t num_max_contacts, bool exhaustive, bool use_mesh)
 {
@@ -371,6 +765,13 @@ void broad_phase_update_collision_test(S env_scale, std::size_t env_size, std::s
 
   managers.push_back(new SaPCollisionManager<S>());
   managers.push_back(new IntervalTreeCollisionManager<S>());
+  managers.push_back(new BatchSaPCollisionManager<S>());
+
+  {
+    BatchSaPCollisionManager<S>* m = new BatchSaPCollisionManager<S>();
+    m->sweep_pool = std::make_shared<ThreadPool>(4);
+    managers.push_back(m);
+  }
 
   Vector3<S> lower_limit, upper_limit;
   SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
@@ -41,6 +41,7 @@
 #include "fcl/broadphase/broadphase_bruteforce.h"
 #include "fcl/broadphase/broadphase_spatialhash.h"
 #include "fcl/broadphase/broadphase_SaP.h"
+#include "fcl/broadphase/broadphase_batch_SaP.h"
 #include "fcl/broadphase/broadphase_SSaP.h"
 #include "fcl/broadphase/broadphase_interval_tree.h"
 #include "fcl/broadphase/broadphase_dynamic_AABB_tree.h"
@@ -205,6 +206,13 @@ void broad_phase_collision_test(S env_scale, std::size_t env_size, std::size_t q
   managers.push_back(new SSaPCollisionManager<S>());
   managers.push_back(new SaPCollisionManager<S>());
   managers.push_back(new IntervalTreeCollisionManager<S>());
+  managers.push_back(new BatchSaPCollisionManager<S>());
+
+  {
+    BatchSaPCollisionManager<S>* m = new BatchSaPCollisionManager<S>();
+    m->sweep_pool = std::make_shared<ThreadPool>(4);
+    managers.push_back(m);
+  }
 
   Vector3<S> lower_limit, upper_limit;
   SpatialHashingCollisionManager<S>::computeBound(env, lower_limit, upper_limit);
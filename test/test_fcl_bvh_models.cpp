@@ -38,7 +38,10 @@
 
 #include "fcl/config.h"
 #include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/narrowphase/collision.h"
 #include "test_fcl_utility.h"
+#include "fcl_resources/config.h"
+#include <cstring>
 #include <iostream>
 
 using namespace fcl;
@@ -223,6 +226,276 @@ GTEST_TEST(FCL_BVH_MODELS, building_bvh_models)
   testBVHModel<KDOP<double, 24> >();
 }
 
+template <typename S>
+S surfaceArea(const AABB<S>& bv)
+{
+  const Vector3<S> d = bv.max_ - bv.min_;
+  return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+}
+
+template <typename S>
+S surfaceArea(const OBB<S>& bv)
+{
+  const Vector3<S>& e = bv.extent;
+  return 8 * (e[0] * e[1] + e[1] * e[2] + e[2] * e[0]);
+}
+
+// Sum of the surface areas of the internal nodes, i.e. the SAH cost of the
+// hierarchy up to the constant factors
+template <typename BV>
+typename BV::S totalSAHCost(const BVHModel<BV>& model, int id)
+{
+  const BVNode<BV>& node = model.getBV(id);
+  if(node.isLeaf())
+    return 0;
+
+  return surfaceArea(node.bv)
+      + totalSAHCost(model, node.leftChild())
+      + totalSAHCost(model, node.rightChild());
+}
+
+template <typename BV>
+typename BV::S buildAndComputeSAHCost(
+    const std::vector<Vector3<typename BV::S>>& points,
+    const std::vector<Triangle>& tri_indices,
+    detail::SplitMethodType split_method)
+{
+  BVHModel<BV> model;
+  model.bv_splitter.reset(new detail::BVSplitter<BV>(split_method));
+  model.beginModel();
+  model.addSubModel(points, tri_indices);
+  model.endModel();
+
+  return totalSAHCost(model, 0);
+}
+
+template <typename BV>
+void testSAHSplit()
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> tri_indices;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", points, tri_indices);
+
+  const S mean_cost = buildAndComputeSAHCost<BV>(
+        points, tri_indices, detail::SPLIT_METHOD_MEAN);
+  const S sah_cost = buildAndComputeSAHCost<BV>(
+        points, tri_indices, detail::SPLIT_METHOD_SAH);
+
+  EXPECT_TRUE(sah_cost < 0.9 * mean_cost);
+
+  // A splitter shared by several builds reuses its scratch buffers and must
+  // give the same hierarchy every time
+  std::shared_ptr<detail::BVSplitterBase<BV>> splitter(
+        new detail::BVSplitter<BV>(detail::SPLIT_METHOD_SAH));
+  for(int i = 0; i < 2; ++i)
+  {
+    BVHModel<BV> model;
+    model.bv_splitter = splitter;
+    model.beginModel();
+    model.addSubModel(points, tri_indices);
+    model.endModel();
+    EXPECT_EQ(totalSAHCost(model, 0), sah_cost);
+  }
+}
+
+GTEST_TEST(FCL_BVH_MODELS, sah_split)
+{
+  testSAHSplit<AABB<double>>();
+  testSAHSplit<OBB<double>>();
+}
+
+template <typename BV>
+void buildModel(BVHModel<BV>& model,
+                const std::vector<Vector3<typename BV::S>>& points,
+                const std::vector<Triangle>& tri_indices,
+                detail::SplitMethodType split_method)
+{
+  model.bv_splitter.reset(new detail::BVSplitter<BV>(split_method));
+  model.beginModel();
+  if(tri_indices.empty())
+    model.addSubModel(points);
+  else
+    model.addSubModel(points, tri_indices);
+  model.endModel();
+}
+
+template <typename BV>
+bool sameBits(const BV& a, const BV& b)
+{
+  return std::memcmp(&a, &b, sizeof(BV)) == 0;
+}
+
+// The spheres of a kIOS past num_spheres are left uninitialized
+template <typename S>
+bool sameBits(const kIOS<S>& a, const kIOS<S>& b)
+{
+  if(a.num_spheres != b.num_spheres || !sameBits(a.obb, b.obb))
+    return false;
+
+  for(unsigned int i = 0; i < a.num_spheres; ++i)
+  {
+    if(std::memcmp(&a.spheres[i], &b.spheres[i], sizeof(a.spheres[i])) != 0)
+      return false;
+  }
+
+  return true;
+}
+
+template <typename BV>
+void testParallelBuild(const std::vector<Vector3<typename BV::S>>& points,
+                       const std::vector<Triangle>& tri_indices,
+                       detail::SplitMethodType split_method)
+{
+  BVHModel<BV> serial_model;
+  buildModel(serial_model, points, tri_indices, split_method);
+
+  BVHModel<BV> parallel_model;
+  parallel_model.build_pool = std::make_shared<ThreadPool>(4);
+  parallel_model.parallel_build_threshold = 16;
+  buildModel(parallel_model, points, tri_indices, split_method);
+
+  GTEST_ASSERT_EQ(parallel_model.getNumBVs(), serial_model.getNumBVs());
+  for(int i = 0; i < serial_model.getNumBVs(); ++i)
+  {
+    const BVNode<BV>& serial_node = serial_model.getBV(i);
+    const BVNode<BV>& parallel_node = parallel_model.getBV(i);
+    EXPECT_EQ(parallel_node.first_child, serial_node.first_child);
+    EXPECT_EQ(parallel_node.first_primitive, serial_node.first_primitive);
+    EXPECT_EQ(parallel_node.num_primitives, serial_node.num_primitives);
+    EXPECT_TRUE(sameBits(parallel_node.bv, serial_node.bv));
+  }
+}
+
+GTEST_TEST(FCL_BVH_MODELS, parallel_build)
+{
+  std::vector<Vector3<double>> points;
+  std::vector<Triangle> tri_indices;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", points, tri_indices);
+  const std::vector<Triangle> no_triangles;
+
+  for(auto split_method : {detail::SPLIT_METHOD_MEAN, detail::SPLIT_METHOD_SAH})
+  {
+    testParallelBuild<AABB<double>>(points, tri_indices, split_method);
+    testParallelBuild<OBB<double>>(points, tri_indices, split_method);
+    testParallelBuild<RSS<double>>(points, tri_indices, split_method);
+    testParallelBuild<kIOS<double>>(points, tri_indices, split_method);
+    testParallelBuild<OBBRSS<double>>(points, tri_indices, split_method);
+    testParallelBuild<KDOP<double, 24>>(points, tri_indices, split_method);
+    testParallelBuild<OBBRSS<double>>(points, no_triangles, split_method);
+  }
+}
+
+template <typename BV>
+void checkHierarchy(const BVHModel<BV>& model, int num_primitives)
+{
+  GTEST_ASSERT_EQ(model.getNumBVs(), 2 * num_primitives - 1);
+
+  std::vector<int> num_leaves(num_primitives, 0);
+  for(int i = 0; i < model.getNumBVs(); ++i)
+  {
+    const BVNode<BV>& node = model.getBV(i);
+    if(node.isLeaf())
+    {
+      EXPECT_EQ(node.num_primitives, 1);
+      ++num_leaves[node.primitiveId()];
+      continue;
+    }
+
+    const BVNode<BV>& left = model.getBV(node.leftChild());
+    const BVNode<BV>& right = model.getBV(node.rightChild());
+    EXPECT_EQ(left.first_primitive, node.first_primitive);
+    EXPECT_EQ(right.first_primitive, left.first_primitive + left.num_primitives);
+    EXPECT_EQ(left.num_primitives + right.num_primitives, node.num_primitives);
+    EXPECT_TRUE(left.num_primitives > 0 && right.num_primitives > 0);
+  }
+
+  for(int i = 0; i < num_primitives; ++i)
+    EXPECT_EQ(num_leaves[i], 1);
+}
+
+template <typename BV>
+void testLBVHBuild(const std::vector<Vector3<typename BV::S>>& points1,
+                   const std::vector<Triangle>& tri_indices1,
+                   const std::vector<Vector3<typename BV::S>>& points2,
+                   const std::vector<Triangle>& tri_indices2)
+{
+  using S = typename BV::S;
+
+  auto lbvh_model = std::make_shared<BVHModel<BV>>();
+  lbvh_model->build_method = BVH_BUILD_METHOD_LBVH;
+  buildModel(*lbvh_model, points1, tri_indices1, detail::SPLIT_METHOD_MEAN);
+  checkHierarchy(*lbvh_model, static_cast<int>(tri_indices1.size()));
+
+  // The parallel build gives the same hierarchy
+  BVHModel<BV> parallel_model;
+  parallel_model.build_method = BVH_BUILD_METHOD_LBVH;
+  parallel_model.build_pool = std::make_shared<ThreadPool>(4);
+  parallel_model.parallel_build_threshold = 16;
+  buildModel(parallel_model, points1, tri_indices1, detail::SPLIT_METHOD_MEAN);
+  GTEST_ASSERT_EQ(parallel_model.getNumBVs(), lbvh_model->getNumBVs());
+  for(int i = 0; i < lbvh_model->getNumBVs(); ++i)
+  {
+    const BVNode<BV>& node = lbvh_model->getBV(i);
+    const BVNode<BV>& parallel_node = parallel_model.getBV(i);
+    EXPECT_EQ(parallel_node.first_child, node.first_child);
+    EXPECT_EQ(parallel_node.first_primitive, node.first_primitive);
+    EXPECT_EQ(parallel_node.num_primitives, node.num_primitives);
+    EXPECT_TRUE(sameBits(parallel_node.bv, node.bv));
+  }
+
+  // Queries find the same contacts as on a top-down hierarchy
+  auto top_down_model = std::make_shared<BVHModel<BV>>();
+  buildModel(*top_down_model, points1, tri_indices1, detail::SPLIT_METHOD_MEAN);
+  auto other_model = std::make_shared<BVHModel<BV>>();
+  buildModel(*other_model, points2, tri_indices2, detail::SPLIT_METHOD_MEAN);
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  test::generateRandomTransforms(extents, transforms, 10);
+
+  CollisionRequest<S> request(100000, false);
+  for(const Transform3<S>& tf : transforms)
+  {
+    CollisionResult<S> lbvh_result;
+    collide(lbvh_model.get(), Transform3<S>::Identity(), other_model.get(), tf,
+            request, lbvh_result);
+
+    CollisionResult<S> top_down_result;
+    collide(top_down_model.get(), Transform3<S>::Identity(), other_model.get(), tf,
+            request, top_down_result);
+
+    EXPECT_EQ(lbvh_result.numContacts(), top_down_result.numContacts());
+  }
+}
+
+GTEST_TEST(FCL_BVH_MODELS, lbvh_build)
+{
+  std::vector<Vector3<double>> points1, points2;
+  std::vector<Triangle> tri_indices1, tri_indices2;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", points1, tri_indices1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", points2, tri_indices2);
+
+  testLBVHBuild<AABB<double>>(points1, tri_indices1, points2, tri_indices2);
+  testLBVHBuild<OBB<double>>(points1, tri_indices1, points2, tri_indices2);
+  testLBVHBuild<RSS<double>>(points1, tri_indices1, points2, tri_indices2);
+  testLBVHBuild<OBBRSS<double>>(points1, tri_indices1, points2, tri_indices2);
+  testLBVHBuild<KDOP<double, 24>>(points1, tri_indices1, points2, tri_indices2);
+
+  // Point clouds, and codes that are all equal
+  BVHModel<AABB<double>> model;
+  model.build_method = BVH_BUILD_METHOD_LBVH;
+  buildModel(model, points1, std::vector<Triangle>(), detail::SPLIT_METHOD_MEAN);
+  checkHierarchy(model, static_cast<int>(points1.size()));
+
+  BVHModel<AABB<double>> degenerate_model;
+  degenerate_model.build_method = BVH_BUILD_METHOD_LBVH;
+  buildModel(degenerate_model, std::vector<Vector3<double>>(5, Vector3<double>::Ones()),
+             std::vector<Triangle>(), detail::SPLIT_METHOD_MEAN);
+  checkHierarchy(degenerate_model, 5);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -38,6 +38,8 @@
 #include <gtest/gtest.h>
 
 #include "fcl/math/bv/utility.h"
+#include "fcl/math/bv/OBB_packet.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
 #include "fcl/narrowphase/collision.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
@@ -294,6 +296,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<OBB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test<RSS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -318,6 +328,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<RSS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test<AABB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -342,6 +360,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<AABB<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test<KDOP<S, 24> >(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -366,6 +392,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<KDOP<S, 24> >(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test<KDOP<S, 18> >(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -657,6 +691,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<kIOS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test2<kIOS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -753,6 +795,14 @@ void test_mesh_mesh()
       EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
     }
 
+    collide_Test<OBBRSS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_SAH, verbose);
+    EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
+    for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
+    {
+      EXPECT_TRUE(global_pairs<S>()[j].b1 == global_pairs_now<S>()[j].b1);
+      EXPECT_TRUE(global_pairs<S>()[j].b2 == global_pairs_now<S>()[j].b2);
+    }
+
     collide_Test2<OBBRSS<S>>(transforms[i], p1, t1, p2, t2, detail::SPLIT_METHOD_MEAN, verbose);
     EXPECT_TRUE(global_pairs<S>().size() == global_pairs_now<S>().size());
     for(std::size_t j = 0; j < global_pairs<S>().size(); ++j)
@@ -827,6 +877,246 @@ void test_mesh_mesh()
   }
 }
 
+template <typename S>
+void test_OBB_packet_test()
+{
+  S extents[] = {-20, -20, -20, 20, 20, 20};
+  std::size_t n = 1000;
+
+  aligned_vector<Transform3<S>> transforms;
+  aligned_vector<Transform3<S>> box_transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+  test::generateRandomTransforms(extents, box_transforms, 5 * n);
+
+  std::size_t num_overlaps = 0;
+  for(std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    const Matrix3<S> R = transforms[i].linear();
+    const Vector3<S> T = transforms[i].translation();
+
+    OBB<S> a(box_transforms[5 * i].linear(), box_transforms[5 * i].translation(),
+             Vector3<S>(10, 5, 2));
+
+    OBBPacket<S, 4> packet;
+    std::vector<OBB<S>> boxes;
+    for(std::size_t j = 1; j < 5; ++j)
+    {
+      const Transform3<S>& tf = box_transforms[5 * i + j];
+      boxes.push_back(OBB<S>(tf.linear(), tf.translation(), Vector3<S>(j, 3, 8)));
+      packet.push_back(boxes.back());
+    }
+
+    const Eigen::Array<bool, 4, 1> disjoint = obbDisjoint(R, T, a, packet);
+    for(std::size_t j = 0; j < boxes.size(); ++j)
+    {
+      const bool overlap_obb = overlap(R, T, a, boxes[j]);
+      EXPECT_EQ(!disjoint[j], overlap_obb);
+      if(overlap_obb)
+        ++num_overlaps;
+    }
+  }
+
+  EXPECT_TRUE(num_overlaps > 0);
+  EXPECT_TRUE(num_overlaps < 4 * n);
+}
+
+template <typename BV>
+int binaryDepth(const BVHModel<BV>& model, int id)
+{
+  const BVNode<BV>& node = model.getBV(id);
+  if(node.isLeaf())
+    return 0;
+
+  return 1 + std::max(binaryDepth(model, node.leftChild()),
+                      binaryDepth(model, node.rightChild()));
+}
+
+template <typename BV, int N>
+void checkWideBVH(const BVHModel<BV>& model, const WideBVH<BV, N>& wide)
+{
+  // Every node of the binary hierarchy but the root is the child of at most
+  // one wide node, and every leaf is the child of exactly one
+  std::vector<int> num_parents(model.getNumBVs(), 0);
+  for(int i = 0; i < wide.getNumNodes(); ++i)
+  {
+    const WideBVNode<typename BV::S, N>& node = wide.getNode(i);
+    EXPECT_TRUE(node.num_children >= 2 && node.num_children <= N);
+    EXPECT_EQ(node.bounds.size, node.num_children);
+
+    for(int j = 0; j < node.num_children; ++j)
+    {
+      ++num_parents[node.bv_index[j]];
+      EXPECT_EQ(node.isChildLeaf(j), model.getBV(node.bv_index[j]).isLeaf());
+    }
+  }
+
+  for(int i = 0; i < model.getNumBVs(); ++i)
+  {
+    EXPECT_TRUE(num_parents[i] <= 1);
+    if(model.getBV(i).isLeaf())
+    {
+      EXPECT_EQ(num_parents[i], 1);
+    }
+  }
+
+  EXPECT_TRUE(wide.getDepth() < binaryDepth(model, 0));
+}
+
+template <typename S>
+std::vector<std::pair<int, int>> contactPrimitives(const CollisionResult<S>& result)
+{
+  std::vector<std::pair<int, int>> primitives;
+  for(std::size_t i = 0; i < result.numContacts(); ++i)
+  {
+    const Contact<S>& contact = result.getContact(i);
+    primitives.emplace_back(contact.b1, contact.b2);
+  }
+  std::sort(primitives.begin(), primitives.end());
+
+  return primitives;
+}
+
+template <typename BV>
+void test_wide_bvh()
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> m1;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+
+  BVHModel<BV> m2;
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  EXPECT_EQ(m1.buildWideBVH(3), BVH_ERR_UNSUPPORTED_FUNCTION);
+
+  BVHModel<BV> m1_wide4(m1), m2_wide4(m2), m1_wide8(m1), m2_wide8(m2);
+  EXPECT_EQ(m1_wide4.buildWideBVH(4), BVH_OK);
+  EXPECT_EQ(m2_wide4.buildWideBVH(4), BVH_OK);
+  EXPECT_EQ(m1_wide8.buildWideBVH(8), BVH_OK);
+  EXPECT_EQ(m2_wide8.buildWideBVH(8), BVH_OK);
+  GTEST_ASSERT_EQ(m1_wide4.getWideBVH8(), nullptr);
+  GTEST_ASSERT_EQ(m1_wide8.getWideBVH4(), nullptr);
+
+  checkWideBVH(m1_wide4, *m1_wide4.getWideBVH4());
+  checkWideBVH(m2_wide4, *m2_wide4.getWideBVH4());
+  checkWideBVH(m1_wide8, *m1_wide8.getWideBVH8());
+  checkWideBVH(m2_wide8, *m2_wide8.getWideBVH8());
+  EXPECT_TRUE(m1_wide8.getWideBVH8()->getDepth() < m1_wide4.getWideBVH4()->getDepth());
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 100;
+#else
+  std::size_t n = 10;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  CollisionRequest<S> request(num_max_contacts, false);
+
+  std::size_t num_collisions = 0;
+  for(std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    CollisionResult<S> result, result_wide4, result_wide8;
+    collide(&m1, Transform3<S>::Identity(), &m2, transforms[i], request, result);
+    collide(&m1_wide4, Transform3<S>::Identity(), &m2_wide4, transforms[i], request, result_wide4);
+    collide(&m1_wide8, Transform3<S>::Identity(), &m2_wide8, transforms[i], request, result_wide8);
+
+    const std::vector<std::pair<int, int>> expected = contactPrimitives(result);
+    EXPECT_TRUE(contactPrimitives(result_wide4) == expected);
+    EXPECT_TRUE(contactPrimitives(result_wide8) == expected);
+
+    if(result.isCollision())
+      ++num_collisions;
+  }
+
+  EXPECT_TRUE(num_collisions > 0);
+
+  // The wide hierarchy is dropped as soon as the binary one changes
+  m1_wide4.beginReplaceModel();
+  m1_wide4.replaceSubModel(p1);
+  m1_wide4.endReplaceModel();
+  EXPECT_EQ(m1_wide4.getWideBVH4(), nullptr);
+}
+
+template <typename S>
+void test_collide_batch()
+{
+  using BV = OBBRSS<S>;
+
+  auto mesh = std::make_shared<BVHModel<BV>>();
+  generateBVHModel(*mesh, Box<S>(10, 10, 10), Transform3<S>::Identity());
+
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> geometries;
+  geometries.push_back(std::make_shared<Box<S>>(10, 10, 10));
+  geometries.push_back(std::make_shared<Sphere<S>>(5));
+  geometries.push_back(std::make_shared<Capsule<S>>(3, 10));
+  geometries.push_back(mesh);
+
+  S extents[] = {-30, -30, -30, 30, 30, 30};
+  std::size_t n = 80;
+
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+
+  std::vector<std::unique_ptr<CollisionObject<S>>> objects;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    objects.emplace_back(new CollisionObject<S>(
+        geometries[i % geometries.size()], transforms[i]));
+  }
+
+  std::vector<CollisionObjectPair<S>> pairs;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    for(std::size_t j = i + 1; j < n; ++j)
+      pairs.emplace_back(objects[i].get(), objects[j].get());
+  }
+
+  CollisionRequest<S> request(num_max_contacts, enable_contact);
+
+  std::vector<CollisionResult<S>> expected(pairs.size());
+  std::size_t num_collisions = 0;
+  for(std::size_t i = 0; i < pairs.size(); ++i)
+  {
+    collide(pairs[i].first, pairs[i].second, request, expected[i]);
+    if(expected[i].isCollision())
+      ++num_collisions;
+  }
+  EXPECT_TRUE(num_collisions > 0);
+
+  ThreadPool pool(4);
+  for(ThreadPool* batch_pool : {static_cast<ThreadPool*>(nullptr), &pool})
+  {
+    std::vector<CollisionResult<S>> results;
+    EXPECT_EQ(collideBatch(pairs, request, results, batch_pool), num_collisions);
+    GTEST_ASSERT_EQ(results.size(), pairs.size());
+
+    for(std::size_t i = 0; i < pairs.size(); ++i)
+    {
+      EXPECT_EQ(results[i].isCollision(), expected[i].isCollision());
+      GTEST_ASSERT_EQ(results[i].numContacts(), expected[i].numContacts());
+      for(std::size_t j = 0; j < results[i].numContacts(); ++j)
+      {
+        EXPECT_TRUE(results[i].getContact(j).o1 == expected[i].getContact(j).o1);
+        EXPECT_TRUE(results[i].getContact(j).o2 == expected[i].getContact(j).o2);
+        EXPECT_TRUE(results[i].getContact(j).b1 == expected[i].getContact(j).b1);
+        EXPECT_TRUE(results[i].getContact(j).b2 == expected[i].getContact(j).b2);
+      }
+    }
+  }
+}
+
 GTEST_TEST(FCL_COLLISION, OBB_Box_test)
 {
 //  test_OBB_Box_test<float>();
@@ -842,6 +1132,12 @@ GTEST_TEST(FCL_COLLISION, OBB_shape_test)
   test_OBB_shape_test<double>();
 }
 
+GTEST_TEST(FCL_COLLISION, OBB_packet_test)
+{
+  test_OBB_packet_test<float>();
+  test_OBB_packet_test<double>();
+}
+
 GTEST_TEST(FCL_COLLISION, OBB_AABB_test)
 {
 //  test_OBB_AABB_test<float>();
@@ -854,6 +1150,19 @@ GTEST_TEST(FCL_COLLISION, mesh_mesh)
   test_mesh_mesh<double>();
 }
 
+GTEST_TEST(FCL_COLLISION, wide_bvh)
+{
+  test_wide_bvh<OBB<double>>();
+  test_wide_bvh<RSS<double>>();
+  test_wide_bvh<OBBRSS<double>>();
+}
+
+GTEST_TEST(FCL_COLLISION, collide_batch)
+{
+//  test_collide_batch<float>();
+  test_collide_batch<double>();
+}
+
 template<typename BV>
 bool collide_Test2(const Transform3<typename BV::S>& tf,
                    const std::vector<Vector3<typename BV::S>>& vertices1, const std::vector<Triangle>& triangles1,
@@ -37,6 +37,8 @@
 
 #include <gtest/gtest.h>
 
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/distance.h"
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 #include "test_fcl_utility.h"
 #include "fcl_resources/config.h"
@@ -305,6 +307,131 @@ GTEST_TEST(FCL_DISTANCE, mesh_distance)
   test_mesh_distance<double>();
 }
 
+template <typename BV>
+void test_wide_bvh_distance()
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> m1;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+
+  BVHModel<BV> m2;
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  BVHModel<BV> m1_wide4(m1), m2_wide4(m2), m1_wide8(m1), m2_wide8(m2);
+  m1_wide4.buildWideBVH(4);
+  m2_wide4.buildWideBVH(4);
+  m1_wide8.buildWideBVH(8);
+  m2_wide8.buildWideBVH(8);
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 100;
+#else
+  std::size_t n = 10;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  DistanceRequest<S> request;
+
+  for(std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    DistanceResult<S> result, result_wide4, result_wide8;
+    distance(&m1, Transform3<S>::Identity(), &m2, transforms[i], request, result);
+    distance(&m1_wide4, Transform3<S>::Identity(), &m2_wide4, transforms[i], request, result_wide4);
+    distance(&m1_wide8, Transform3<S>::Identity(), &m2_wide8, transforms[i], request, result_wide8);
+
+    EXPECT_NEAR(result_wide4.min_distance, result.min_distance, DELTA<S>());
+    EXPECT_NEAR(result_wide8.min_distance, result.min_distance, DELTA<S>());
+  }
+}
+
+GTEST_TEST(FCL_DISTANCE, wide_bvh_distance)
+{
+  test_wide_bvh_distance<RSS<double>>();
+  test_wide_bvh_distance<OBBRSS<double>>();
+}
+
+template <typename S>
+void test_distance_batch()
+{
+  using BV = OBBRSS<S>;
+
+  auto mesh = std::make_shared<BVHModel<BV>>();
+  generateBVHModel(*mesh, Box<S>(10, 10, 10), Transform3<S>::Identity());
+
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> geometries;
+  geometries.push_back(std::make_shared<Box<S>>(10, 10, 10));
+  geometries.push_back(std::make_shared<Sphere<S>>(5));
+  geometries.push_back(std::make_shared<Capsule<S>>(3, 10));
+  geometries.push_back(mesh);
+
+  // Objects are placed on a grid so that no two of them overlap
+  S extents[] = {-1, -1, -1, 1, 1, 1};
+  std::size_t n = 40;
+
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, n);
+
+  std::vector<std::unique_ptr<CollisionObject<S>>> objects;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    transforms[i].translation() += 30 * Vector3<S>(i % 4, (i / 4) % 4, i / 16);
+    objects.emplace_back(new CollisionObject<S>(
+        geometries[i % geometries.size()], transforms[i]));
+  }
+
+  std::vector<CollisionObjectPair<S>> pairs;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    for(std::size_t j = i + 1; j < n; ++j)
+      pairs.emplace_back(objects[i].get(), objects[j].get());
+  }
+
+  DistanceRequest<S> request(true);
+  request.gjk_solver_type = GST_INDEP;
+
+  std::vector<DistanceResult<S>> expected(pairs.size());
+  S min_distance = std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < pairs.size(); ++i)
+  {
+    distance(pairs[i].first, pairs[i].second, request, expected[i]);
+    min_distance = std::min(min_distance, expected[i].min_distance);
+  }
+
+  ThreadPool pool(4);
+  for(ThreadPool* batch_pool : {static_cast<ThreadPool*>(nullptr), &pool})
+  {
+    std::vector<DistanceResult<S>> results;
+    EXPECT_EQ(distanceBatch(pairs, request, results, batch_pool), min_distance);
+    GTEST_ASSERT_EQ(results.size(), pairs.size());
+
+    for(std::size_t i = 0; i < pairs.size(); ++i)
+    {
+      EXPECT_EQ(results[i].min_distance, expected[i].min_distance) << pairs[i].first->getNodeType() << " " << pairs[i].second->getNodeType();
+      EXPECT_TRUE(results[i].nearest_points[0].isApprox(expected[i].nearest_points[0]));
+      EXPECT_TRUE(results[i].nearest_points[1].isApprox(expected[i].nearest_points[1]));
+    }
+  }
+}
+
+GTEST_TEST(FCL_DISTANCE, distance_batch)
+{
+//  test_distance_batch<float>();
+  test_distance_batch<double>();
+}
+
 template<typename BV, typename TraversalNode>
 void distance_Test_Oriented(const Transform3<typename BV::S>& tf,
                             const std::vector<Vector3<typename BV::S>>& vertices1, const std::vector<Triangle>& triangles1,
@@ -46,6 +46,7 @@
 #include "fcl/math/motion/translation_motion.h"
 
 #include "fcl/geometry/shape/cone.h"
+#include "fcl/geometry/shape/convex.h"
 #include "fcl/geometry/shape/capsule.h"
 #include "fcl/geometry/shape/ellipsoid.h"
 #include "fcl/geometry/shape/halfspace.h"
@@ -54,6 +55,7 @@
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
 #include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
 
 #include "test_fcl_utility.h"
 
@@ -174,6 +176,202 @@ GTEST_TEST(FCL_GEOMETRIC_SHAPES, gjkcache)
   test_gjkcache<double>();
 }
 
+template <typename S>
+void test_gjk_warm_start()
+{
+  Cylinder<S> s1(5, 10);
+  Cone<S> s2(5, 10);
+  Box<S> s3(4, 6, 8);
+
+  GJKCache<S> cache;
+
+  CollisionRequest<S> request;
+  request.gjk_solver_type = GST_INDEP;
+  CollisionRequest<S> cached_request = request;
+  cached_request.gjk_cache = &cache;
+
+  DistanceRequest<S> distance_request;
+  distance_request.gjk_solver_type = GST_INDEP;
+  DistanceRequest<S> cached_distance_request = distance_request;
+  cached_distance_request.gjk_cache = &cache;
+
+  TranslationMotion<S> motion(Transform3<S>(Translation3<S>(Vector3<S>(-20.0, -20.0, -20.0))), Transform3<S>(Translation3<S>(Vector3<S>(20.0, 20.0, 20.0))));
+
+  // Small steps both in and out of collision, as in a control loop
+  int N = 2000;
+  S dt = 1.0 / (N - 1);
+  for(int i = 0; i < N; ++i)
+  {
+    motion.integrate(dt * i);
+    Transform3<S> tf;
+    motion.getCurrentTransform(tf);
+    tf.linear() = AngleAxis<S>(0.001 * i, Vector3<S>::UnitZ()).toRotationMatrix();
+
+    CollisionResult<S> result;
+    CollisionResult<S> cached_result;
+    collide(&s1, Transform3<S>::Identity(), &s2, tf, request, result);
+    collide(&s1, Transform3<S>::Identity(), &s2, tf, cached_request, cached_result);
+    EXPECT_EQ(result.isCollision(), cached_result.isCollision());
+
+    DistanceResult<S> distance_result;
+    DistanceResult<S> cached_distance_result;
+    distance(&s1, Transform3<S>::Identity(), &s3, tf, distance_request, distance_result);
+    distance(&s1, Transform3<S>::Identity(), &s3, tf, cached_distance_request, cached_distance_result);
+    EXPECT_NEAR(distance_result.min_distance, cached_distance_result.min_distance, 1e-4);
+  }
+
+  // One warm start per ordered pair of geometries
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_LT(0u, cache.get(&s1, &s2).rank);
+  EXPECT_EQ(cache.size(), 2u);
+
+  cache.invalidate(&s2);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.get(&s2, &s1).rank, 0u);
+  EXPECT_EQ(cache.size(), 2u);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, gjk_warm_start)
+{
+//  test_gjk_warm_start<float>();
+  test_gjk_warm_start<double>();
+}
+
+/// Convex polytope inscribed in a sphere of the given radius, with quads
+/// between num_rings - 1 rings of num_segments points and triangles at the
+/// poles
+template <typename S>
+struct ConvexSphere
+{
+  ConvexSphere(S radius, int num_rings, int num_segments)
+  {
+    const S pi = constants<S>::pi();
+
+    points.push_back(Vector3<S>(0, 0, radius));
+    for(int i = 1; i < num_rings; ++i)
+    {
+      const S theta = pi * i / num_rings;
+      for(int j = 0; j < num_segments; ++j)
+      {
+        const S phi = 2 * pi * j / num_segments;
+        points.push_back(radius * Vector3<S>(std::sin(theta) * std::cos(phi),
+                                             std::sin(theta) * std::sin(phi),
+                                             std::cos(theta)));
+      }
+    }
+    points.push_back(Vector3<S>(0, 0, -radius));
+
+    const int south = static_cast<int>(points.size()) - 1;
+    auto ring = [num_segments](int i, int j)
+    {
+      return 1 + (i - 1) * num_segments + j % num_segments;
+    };
+
+    std::vector<std::vector<int>> faces;
+    for(int j = 0; j < num_segments; ++j)
+    {
+      faces.push_back({0, ring(1, j), ring(1, j + 1)});
+      for(int i = 1; i + 1 < num_rings; ++i)
+        faces.push_back({ring(i, j), ring(i + 1, j), ring(i + 1, j + 1), ring(i, j + 1)});
+      faces.push_back({south, ring(num_rings - 1, j + 1), ring(num_rings - 1, j)});
+    }
+
+    for(const auto& face : faces)
+    {
+      polygons.push_back(static_cast<int>(face.size()));
+      polygons.insert(polygons.end(), face.begin(), face.end());
+
+      Vector3<S> normal = (points[face[1]] - points[face[0]]).cross(
+            points[face[2]] - points[face[0]]).normalized();
+      plane_normals.push_back(normal);
+      plane_dis.push_back(normal.dot(points[face[0]]));
+    }
+
+    convex.reset(new Convex<S>(plane_normals.data(), plane_dis.data(),
+                               static_cast<int>(faces.size()), points.data(),
+                               static_cast<int>(points.size()),
+                               polygons.data()));
+  }
+
+  std::vector<Vector3<S>> points;
+  std::vector<int> polygons;
+  std::vector<Vector3<S>> plane_normals;
+  std::vector<S> plane_dis;
+  std::shared_ptr<Convex<S>> convex;
+};
+
+template <typename S>
+void test_convex_support()
+{
+  ConvexSphere<S> sphere(5, 24, 48);
+  const Convex<S>& convex = *sphere.convex;
+  GTEST_ASSERT_EQ(convex.neighbor_offsets.size(), sphere.points.size() + 1);
+
+  // Every vertex of the quads has four neighbors, the poles one per segment
+  EXPECT_EQ(convex.neighbor_offsets[1], 48);
+  EXPECT_EQ(convex.neighbor_offsets[2] - convex.neighbor_offsets[1], 4);
+
+  // Hill-climbing reaches the furthest point from any start
+  S extents[] = {-10, -10, -10, 10, 10, 10};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, 500);
+  int hint = 0;
+  for(const auto& tf : transforms)
+  {
+    const Vector3<S> dir = tf.translation();
+
+    S maxdot = -std::numeric_limits<S>::max();
+    for(const auto& point : sphere.points)
+      maxdot = std::max(maxdot, dir.dot(point));
+
+    hint = convex.findExtremeVertex(dir, hint);
+    EXPECT_NEAR(dir.dot(sphere.points[hint]), maxdot, tolerance<S>() * 100);
+    EXPECT_NEAR(dir.dot(sphere.points[convex.findExtremeVertex(dir)]), maxdot,
+                tolerance<S>() * 100);
+  }
+
+  // GJK gives the same distances as with the linear scan over the points
+  Convex<S> convex_scan(convex);
+  convex_scan.neighbor_offsets.clear();
+  convex_scan.neighbors.clear();
+
+  Sphere<S> s(1);
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() = Vector3<S>(10, 0, 0);
+
+  S dist;
+  EXPECT_TRUE(solver1<S>().shapeDistance(convex, tf1, s, tf2, &dist));
+  EXPECT_NEAR(dist, 4, 1e-6);
+  EXPECT_TRUE(solver2<S>().shapeDistance(convex, tf1, s, tf2, &dist));
+  EXPECT_NEAR(dist, 4, 1e-6);
+
+  for(const auto& tf : transforms)
+  {
+    S dist_climb, dist_scan;
+    bool res_climb = solver2<S>().shapeDistance(convex, tf1, s, tf, &dist_climb);
+    bool res_scan = solver2<S>().shapeDistance(convex_scan, tf1, s, tf, &dist_scan);
+    EXPECT_EQ(res_climb, res_scan);
+    if(res_climb)
+      EXPECT_NEAR(dist_climb, dist_scan, 1e-6);
+
+    res_climb = solver1<S>().shapeDistance(convex, tf1, s, tf, &dist_climb);
+    res_scan = solver1<S>().shapeDistance(convex_scan, tf1, s, tf, &dist_scan);
+    EXPECT_EQ(res_climb, res_scan);
+    if(res_climb)
+      EXPECT_NEAR(dist_climb, dist_scan, 1e-6);
+  }
+}
+
+GTEST_TEST(FCL_GEOMETRIC_SHAPES, convex_support)
+{
+//  test_convex_support<float>();
+  test_convex_support<double>();
+}
+
 template <typename Shape1, typename Shape2>
 void printComparisonError(const std::string& comparison_type,
                           const Shape1& s1, const Transform3<typename Shape1::S>& tf1,
@@ -32,11 +32,14 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <cstdint>
+
 #include <gtest/gtest.h>
 
 #include "fcl/narrowphase/distance.h"
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "fcl/common/detail/arena.h"
 #include "test_fcl_utility.h"
 #include "fcl_resources/config.h"
 
@@ -98,6 +101,97 @@ GTEST_TEST(FCL_NEGATIVE_DISTANCE, sphere_sphere)
   test_distance_spheresphere<double>(GST_INDEP);
 }
 
+//==============================================================================
+template <typename S>
+void test_distance_arena(GJKSolverType solver_type)
+{
+  // Cylinder and cone have no dedicated distance routine, so penetrating
+  // queries go through GJK and EPA
+  Cylinder<S> s1{5, 10};
+  Cone<S> s2{5, 10};
+
+  Transform3<S> tf1{Transform3<S>::Identity()};
+  Transform3<S> tf2{Transform3<S>::Identity()};
+
+  DistanceRequest<S> request;
+  request.enable_signed_distance = true;
+  request.enable_nearest_points = true;
+  request.gjk_solver_type = solver_type;
+
+  DistanceResult<S> result;
+
+  detail::Arena& arena = detail::Arena::threadLocal();
+  const std::size_t used = arena.getUsed();
+
+  tf2.translation() = Vector3<S>(7, 0, 0);
+  distance(&s1, tf1, &s2, tf2, request, result);
+  EXPECT_LT(result.min_distance, 0);
+
+  // The polytope of the query is given back to the arena ...
+  EXPECT_EQ(arena.getUsed(), used);
+  EXPECT_GT(arena.getCapacity(), 0u);
+
+  // ... and reused by the next queries without growing it
+  const std::size_t capacity = arena.getCapacity();
+  for (int i = 0; i < 100; ++i)
+  {
+    result.clear();
+    tf2.translation() = Vector3<S>(6 + 0.02 * i, 0.01 * i, 0);
+    tf2.linear() = AngleAxis<S>(0.03 * i, Vector3<S>::UnitY()).toRotationMatrix();
+    distance(&s1, tf1, &s2, tf2, request, result);
+    EXPECT_LT(result.min_distance, 0);
+    EXPECT_EQ(arena.getUsed(), used);
+  }
+  EXPECT_EQ(arena.getCapacity(), capacity);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_NEGATIVE_DISTANCE, arena)
+{
+  test_distance_arena<double>(GST_LIBCCD);
+  test_distance_arena<double>(GST_INDEP);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_NEGATIVE_DISTANCE, arena_scope)
+{
+  detail::Arena arena(64);
+
+  void* a = arena.allocate(24, 8);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a) % 8, 0u);
+  EXPECT_EQ(arena.getUsed(), 24u);
+
+  {
+    detail::Arena::Scope scope(arena);
+
+    double* b = arena.allocate<double>(4);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % alignof(double), 0u);
+    for (int i = 0; i < 4; ++i)
+      b[i] = i;
+
+    // Larger than a block: gets a block of its own
+    char* c = static_cast<char*>(arena.allocate(200, 64));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 64, 0u);
+    EXPECT_GE(arena.getCapacity(), 264u);
+  }
+
+  // Everything allocated in the scope is given back, the blocks are kept
+  EXPECT_EQ(arena.getUsed(), 24u);
+  const std::size_t capacity = arena.getCapacity();
+
+  {
+    detail::Arena::Scope scope(arena);
+    arena.allocate<double>(4);
+    arena.allocate(200, 64);
+  }
+  EXPECT_EQ(arena.getUsed(), 24u);
+  EXPECT_EQ(arena.getCapacity(), capacity);
+
+  arena.reset();
+  EXPECT_EQ(arena.getUsed(), 0u);
+  EXPECT_EQ(arena.getCapacity(), capacity);
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {